@@ -3,7 +3,7 @@
 Board::Board(int w, int h) : weight(w), height(h), grid(w * h, -1) {}
 
 bool Board::in_bounds(const Cell& p) const {
-    return p.x >=0 && p.x < weight && p.y >=0 && p.y <= height;
+    return p.x >=0 && p.x < weight && p.y >=0 && p.y < height;
 }
 
 bool Board::is_empty(const Cell& p) const {
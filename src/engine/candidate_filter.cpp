@@ -0,0 +1,152 @@
+#include "candidate_filter.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CANDIDATE_FILTER_X86 1
+#endif
+
+const char* to_string(FilterKernel k) {
+    switch (k) {
+        case FilterKernel::Scalar: return "scalar";
+        case FilterKernel::Avx2:   return "avx2";
+    }
+    return "unknown";
+}
+
+FilterKernel detect_filter_kernel() {
+#ifdef CANDIDATE_FILTER_X86
+    if (__builtin_cpu_supports("avx2")) return FilterKernel::Avx2;
+#endif
+    return FilterKernel::Scalar;
+}
+
+// Survivor offsets are written unconditionally and kept by advancing n, so
+// the loop has no data-dependent branch.
+static int filter_scalar(const uint64_t* masks, const uint64_t* kinds, uint32_t count,
+                         uint64_t occupied, uint64_t exhausted, uint16_t* out) {
+    int n = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        out[n] = (uint16_t)i;
+        n += ((masks[i] & occupied) | (kinds[i] & exhausted)) == 0;
+    }
+    return n;
+}
+
+#ifdef CANDIDATE_FILTER_X86
+__attribute__((target("avx2")))
+static int filter_avx2(const uint64_t* masks, const uint64_t* kinds, uint32_t count,
+                       uint64_t occupied, uint64_t exhausted, uint16_t* out) {
+    const __m256i occ = _mm256_set1_epi64x((long long)occupied);
+    const __m256i exh = _mm256_set1_epi64x((long long)exhausted);
+    const __m256i zero = _mm256_setzero_si256();
+
+    int n = 0;
+    for (uint32_t i = 0; i < count; i += 4) {
+        const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + i));
+        const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kinds + i));
+        const __m256i hit = _mm256_or_si256(_mm256_and_si256(m, occ), _mm256_and_si256(k, exh));
+        unsigned fits = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(hit, zero)));
+
+        // lanes past the bucket end are padding
+        if (count - i < 4) fits &= (1u << (count - i)) - 1;
+        while (fits) {
+            out[n++] = (uint16_t)(i + std::countr_zero(fits));
+            fits &= fits - 1;
+        }
+    }
+    return n;
+}
+#endif
+
+CandidateFilter::CandidateFilter(const PlacementTable& table, FilterKernel k) : kernel(k) {
+    if (table.get_inventory().kind_count() > (size_t)kMaxKinds) {
+        throw std::invalid_argument("CandidateFilter supports at most 64 piece kinds");
+    }
+#ifndef CANDIDATE_FILTER_X86
+    kernel = FilterKernel::Scalar;
+#endif
+
+    const int cells = table.cell_count();
+    begin.resize(cells);
+    count.resize(cells);
+    for (int c = 0; c < cells; ++c) {
+        begin[c] = (uint32_t)masks.size();
+        count[c] = table.bucket_end(c) - table.bucket_begin(c);
+        for (uint32_t k = table.bucket_begin(c); k < table.bucket_end(c); ++k) {
+            masks.push_back(table.at(k).mask);
+            kinds.push_back(1ull << table.at(k).kind_index);
+        }
+        while ((masks.size() - begin[c]) % 4) {
+            masks.push_back(0);
+            kinds.push_back(0);
+        }
+        max_padded = std::max(max_padded, masks.size() - begin[c]);
+    }
+}
+
+int CandidateFilter::filter(int cell, uint64_t occupied, uint64_t exhausted, uint16_t* out) const {
+    const uint64_t* m = masks.data() + begin[cell];
+    const uint64_t* k = kinds.data() + begin[cell];
+#ifdef CANDIDATE_FILTER_X86
+    if (kernel == FilterKernel::Avx2) return filter_avx2(m, k, count[cell], occupied, exhausted, out);
+#endif
+    return filter_scalar(m, k, count[cell], occupied, exhausted, out);
+}
+
+FilteredSearch::FilteredSearch(const PlacementTable& table, FilterKernel kernel)
+    : table(table), filter(table, kernel),
+      survivors(table.get_inventory().piece_count() + 1, std::vector<uint16_t>(filter.capacity())),
+      path(table.get_inventory().piece_count()) {}
+
+bool FilteredSearch::solve() {
+    return count_solutions(1) > 0;
+}
+
+uint64_t FilteredSearch::count_solutions(uint64_t limit_) {
+    limit = limit_;
+    piece_left = table.get_inventory().initial_counts();
+    exhausted = 0;
+    stats = SearchStats{};
+    stopped = dfs(0, 0);
+    return stats.solutions;
+}
+
+// true once the limit is reached; the path then holds the last solution
+bool FilteredSearch::dfs(int depth, uint64_t occupied) {
+    if (occupied == table.full_mask()) {
+        ++stats.solutions;
+        return limit > 0 && stats.solutions >= limit;
+    }
+
+    const int cell = PlacementTable::first_empty(occupied);
+    const uint32_t base = table.bucket_begin(cell);
+    uint16_t* next = survivors[depth].data();
+    const int n = filter.filter(cell, occupied, exhausted, next);
+    stats.placement_tests += table.bucket_end(cell) - base;
+
+    for (int i = 0; i < n; ++i) {
+        const uint32_t k = base + next[i];
+        const TablePlacement& p = table.at(k);
+        const uint64_t bit = 1ull << p.kind_index;
+
+        ++stats.nodes;
+        if (--piece_left[p.kind_index] == 0) exhausted |= bit;
+        path[depth] = k;
+
+        if (dfs(depth + 1, occupied | p.mask)) return true;
+
+        if (piece_left[p.kind_index]++ == 0) exhausted &= ~bit;
+    }
+    return false;
+}
+
+std::vector<Placement> FilteredSearch::get_placements_path() const {
+    std::vector<Placement> out;
+    if (!stopped) return out;
+    for (uint32_t k : path) out.push_back(table.to_placement(k));
+    return out;
+}
@@ -0,0 +1,86 @@
+#ifndef CANDIDATE_FILTER_H
+#define CANDIDATE_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "placement_table.h"
+#include "search_stats.h"
+
+// Batch test of an anchor bucket's placements (boards of at most 64 cells).
+// --------------------------------
+// The bitmask engines test candidates one at a time: "is this kind left, and
+// is its mask clear of the board?". CandidateFilter lays every bucket out as
+// packed arrays (placement masks, one-hot kind bits), padded to a multiple
+// of 4, and tests a whole bucket against the occupancy and the mask of kinds
+// with no copy left in one pass, writing the survivors' bucket offsets to a
+// compact list the search then branches on.
+//
+// Two kernels with identical output, picked once at startup:
+//   Scalar   portable loop, branch-free
+//   Avx2     four candidates per instruction (x86-64, checked with cpuid)
+enum class FilterKernel {
+    Scalar,
+    Avx2,
+};
+
+const char* to_string(FilterKernel k);
+
+// Best kernel this CPU runs.
+FilterKernel detect_filter_kernel();
+
+class CandidateFilter {
+public:
+    static constexpr int kMaxKinds = 64;
+
+    // Throws std::invalid_argument with more than kMaxKinds piece kinds.
+    explicit CandidateFilter(const PlacementTable& table, FilterKernel kernel = detect_filter_kernel());
+
+    // Offsets (from bucket_begin(cell)) of the placements at `cell` that fit
+    // `occupied` and whose kind bit is not in `exhausted`. `out` needs
+    // capacity() entries. Returns the survivor count.
+    int filter(int cell, uint64_t occupied, uint64_t exhausted, uint16_t* out) const;
+
+    // Largest padded bucket, the size `out` must have.
+    size_t capacity() const { return max_padded; }
+
+    FilterKernel get_kernel() const { return kernel; }
+
+private:
+    FilterKernel kernel;
+    std::vector<uint32_t> begin;    // per cell, into masks / kinds (padded)
+    std::vector<uint32_t> count;    // per cell, real candidates
+    std::vector<uint64_t> masks;    // padded with zeros; kernels ignore the padding
+    std::vector<uint64_t> kinds;    // one-hot kind_index
+    size_t max_padded = 0;
+};
+
+// Same search order as IterativeSolver, branching on CandidateFilter
+// survivors. For benchmarks and cross-checks.
+class FilteredSearch {
+public:
+    FilteredSearch(const PlacementTable& table, FilterKernel kernel = detect_filter_kernel());
+
+    bool solve();
+    uint64_t count_solutions(uint64_t limit = 0);
+
+    // The solution the search stopped on (solve(), or count_solutions()
+    // reaching its limit); empty otherwise.
+    std::vector<Placement> get_placements_path() const;
+    const SearchStats& get_stats() const { return stats; }
+
+private:
+    bool dfs(int depth, uint64_t occupied);
+
+    const PlacementTable& table;
+    CandidateFilter filter;
+    std::vector<int> piece_left;
+    uint64_t exhausted = 0;
+    std::vector<std::vector<uint16_t>> survivors;   // per depth
+    std::vector<uint32_t> path;
+    uint64_t limit = 0;
+    bool stopped = false;
+    SearchStats stats;
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "feasibility.h"
+#include "piece_inventory.h"
+
+#include <algorithm>
+
+static Cell extent(const std::vector<Cell>& variant) {
+    // variants are normalized, so the minimum is (0, 0)
+    Cell e{0, 0};
+    for (const auto& c : variant) {
+        e.x = std::max(e.x, c.x + 1);
+        e.y = std::max(e.y, c.y + 1);
+    }
+    return e;
+}
+
+static bool fits(const std::vector<Cell>& variant, int width, int height) {
+    Cell e = extent(variant);
+    return e.x <= width && e.y <= height;
+}
+
+static std::string shape_name(const Piece& piece) {
+    return "Piece " + std::to_string(piece.get_id());
+}
+
+FeasibilityReport check_feasibility(int width, int height, const std::vector<Piece>& pieces) {
+    FeasibilityReport report;
+    PieceInventory inventory(pieces);
+    const auto& kinds = inventory.get_kinds();
+
+    // 1) every piece must fit somewhere
+    for (const auto& kind : kinds) {
+        const auto& variants = kind.piece->get_variants();
+        bool any = std::any_of(variants.begin(), variants.end(),
+                               [&](const auto& v) { return fits(v, width, height); });
+        if (!any) {
+            report.feasible = false;
+            report.reason = shape_name(*kind.piece) + " does not fit on a " +
+                            std::to_string(width) + "x" + std::to_string(height) +
+                            " board in any orientation.";
+            return report;
+        }
+    }
+
+    // 2) checkerboard parity. Dark cells are (x + y) even. A variant covers
+    //    `dark` dark cells at an even offset and size - dark at an odd one;
+    //    the odd offset only exists if the variant can move inside the board.
+    const int board_cells = width * height;
+    const int board_dark = (board_cells + 1) / 2;
+
+    std::vector<char> reachable(board_cells + 1, 0);
+    reachable[0] = 1;
+
+    for (const auto& kind : kinds) {
+        // a copy adds at most its own cell count, so d only runs up to that
+        int max_d = 0;
+        std::vector<char> options(board_cells + 1, 0);
+        for (const auto& v : kind.piece->get_variants()) {
+            if (!fits(v, width, height)) continue;
+            max_d = std::max(max_d, (int)v.size());
+
+            int dark = 0;
+            for (const auto& c : v) dark += ((c.x + c.y) % 2 == 0);
+            options[dark] = 1;
+
+            Cell e = extent(v);
+            if (e.x < width || e.y < height) {
+                options[(int)v.size() - dark] = 1;
+            }
+        }
+
+        for (int copy = 0; copy < kind.count; ++copy) {
+            std::vector<char> next(board_cells + 1, 0);
+            for (int s = 0; s <= board_cells; ++s) {
+                if (!reachable[s]) continue;
+                for (int d = 0; d <= max_d && s + d <= board_cells; ++d) {
+                    if (options[d]) next[s + d] = 1;
+                }
+            }
+            reachable.swap(next);
+        }
+    }
+
+    if (!reachable[board_dark]) {
+        int lo = -1, hi = -1;
+        for (int s = 0; s <= board_cells; ++s) {
+            if (!reachable[s]) continue;
+            if (lo < 0) lo = s;
+            hi = s;
+        }
+        report.feasible = false;
+        report.reason = "Checkerboard parity: the board has " + std::to_string(board_dark) +
+                        " dark cells, but no colouring of the pieces covers exactly that many";
+        if (lo >= 0) {
+            report.reason += " (possible totals lie in " + std::to_string(lo) + ".." +
+                             std::to_string(hi) + ")";
+        }
+        report.reason += ".";
+        return report;
+    }
+
+    // 3) every cell needs at least one placement covering it
+    std::vector<char> covered(board_cells, 0);
+    int covered_count = 0;
+    for (const auto& kind : kinds) {
+        for (const auto& v : kind.piece->get_variants()) {
+            Cell e = extent(v);
+            for (int oy = 0; oy + e.y <= height; ++oy) {
+                for (int ox = 0; ox + e.x <= width; ++ox) {
+                    for (const auto& c : v) {
+                        char& cell = covered[(c.y + oy) * width + (c.x + ox)];
+                        if (!cell) {
+                            cell = 1;
+                            ++covered_count;
+                        }
+                    }
+                }
+            }
+            if (covered_count == board_cells) return report;
+        }
+    }
+
+    for (int i = 0; i < board_cells; ++i) {
+        if (!covered[i]) {
+            report.feasible = false;
+            report.reason = "Cell (" + std::to_string(i % width) + ", " + std::to_string(i / width) +
+                            ") cannot be covered by any piece placement.";
+            return report;
+        }
+    }
+    return report;
+}
@@ -0,0 +1,26 @@
+#ifndef FEASIBILITY_H
+#define FEASIBILITY_H
+
+#include <string>
+#include <vector>
+#include "piece.h"
+
+// Pre-solve analysis
+// --------------------------------
+// Cheap necessary conditions, run before the search so that most unsolvable
+// custom requests are rejected in microseconds:
+// 1. every piece has at least one variant that fits inside the board
+// 2. checkerboard parity: some choice of dark/light split per piece must add
+//    up to the board's number of dark cells
+// 3. every board cell is covered by at least one legal placement
+//
+// Passing all checks does not mean the puzzle is solvable.
+class FeasibilityReport {
+public:
+    bool feasible = true;
+    std::string reason;     // why not, when !feasible
+};
+
+FeasibilityReport check_feasibility(int width, int height, const std::vector<Piece>& pieces);
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef FIXED_SOLVER_H
+#define FIXED_SOLVER_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+#include "piece_inventory.h"
+#include "placement.h"
+
+// Solver kernel specialized for a W x H board (W * H <= 64).
+// --------------------------------
+// Same search as Solver::dfs (first empty cell in row-major order, pieces in
+// order, variants in order), so it returns the same first solution, but:
+// - the board is a 64-bit occupancy mask instead of a grid of ints
+// - every legal placement is precomputed as a mask, bucketed by its first
+//   (row-major) cell, which is the only cell that can land on the empty cell
+// - W and H are compile-time constants, so the index math and the loop
+//   bounds used while building the table fold away
+// - repeated pieces branch once per kind (PieceInventory)
+template <int W, int H>
+class FixedSolver {
+    static_assert(W > 0 && H > 0 && W * H <= 64, "FixedSolver needs a board of at most 64 cells");
+
+public:
+    static constexpr int kCells = W * H;
+    static constexpr uint64_t kFull = kCells == 64 ? ~0ull : ((1ull << kCells) - 1);
+
+    explicit FixedSolver(const std::vector<Piece>& p)
+        : inventory(p), piece_left(inventory.initial_counts()) {
+        build_candidates();
+    }
+
+    bool solve() {
+        reset();
+        return dfs(0);
+    }
+
+    uint64_t count_solutions(uint64_t limit = 0) {
+        reset();
+        uint64_t count = 0;
+        count_dfs(0, count, limit);
+        return count;
+    }
+
+    std::vector<Placement> get_placements_path() const {
+        std::vector<Placement> out;
+        out.reserve(depth);
+        for (int i = 0; i < depth; ++i) {
+            const Candidate& c = candidates[path[i]];
+            out.emplace_back(inventory.get_kinds()[c.kind_index].piece->get_id(), c.variant_index, c.offset);
+        }
+        return out;
+    }
+
+private:
+    struct Candidate {
+        uint64_t mask;
+        int kind_index;
+        int variant_index;
+        Cell offset;
+    };
+
+    static constexpr int index_of(int x, int y) { return y * W + x; }
+    static constexpr bool in_bounds(int x, int y) { return x >= 0 && x < W && y >= 0 && y < H; }
+
+    void build_candidates() {
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                anchor_begin[index_of(x, y)] = (uint32_t)candidates.size();
+
+                const auto& kinds = inventory.get_kinds();
+                for (size_t i = 0; i < kinds.size(); ++i) {
+                    const auto& variants = kinds[i].piece->get_variants();
+                    for (size_t v = 0; v < variants.size(); ++v) {
+                        const auto& variant = variants[v];
+                        // variants are sorted, so variant[0] is the first cell
+                        const Cell offset{x - variant[0].x, y - variant[0].y};
+
+                        uint64_t mask = 0;
+                        bool fits = true;
+                        for (const auto& c : variant) {
+                            const int px = c.x + offset.x, py = c.y + offset.y;
+                            if (!in_bounds(px, py)) {
+                                fits = false;
+                                break;
+                            }
+                            mask |= 1ull << index_of(px, py);
+                        }
+                        if (fits) {
+                            candidates.push_back(Candidate{mask, (int)i, (int)v, offset});
+                        }
+                    }
+                }
+            }
+        }
+        anchor_begin[kCells] = (uint32_t)candidates.size();
+    }
+
+    void reset() {
+        depth = 0;
+        piece_left = inventory.initial_counts();
+    }
+
+    bool dfs(uint64_t occupied) {
+        if (occupied == kFull) return true;
+
+        // first empty cell = lowest zero bit
+        const int cell = std::countr_one(occupied);
+
+        for (uint32_t k = anchor_begin[cell]; k < anchor_begin[cell + 1]; ++k) {
+            const Candidate& c = candidates[k];
+            if (piece_left[c.kind_index] == 0 || (c.mask & occupied)) continue;
+
+            --piece_left[c.kind_index];
+            path[depth++] = k;
+
+            if (dfs(occupied | c.mask)) return true;
+
+            --depth;
+            ++piece_left[c.kind_index];
+        }
+        return false;
+    }
+
+    void count_dfs(uint64_t occupied, uint64_t& count, uint64_t limit) {
+        if (occupied == kFull) {
+            ++count;
+            return;
+        }
+
+        const int cell = std::countr_one(occupied);
+
+        for (uint32_t k = anchor_begin[cell]; k < anchor_begin[cell + 1]; ++k) {
+            const Candidate& c = candidates[k];
+            if (piece_left[c.kind_index] == 0 || (c.mask & occupied)) continue;
+
+            --piece_left[c.kind_index];
+            count_dfs(occupied | c.mask, count, limit);
+            ++piece_left[c.kind_index];
+
+            if (limit > 0 && count >= limit) return;
+        }
+    }
+
+    PieceInventory inventory;
+    std::vector<int> piece_left;    // copies of each kind not placed yet
+
+    std::vector<Candidate> candidates;
+    std::array<uint32_t, kCells + 1> anchor_begin{};
+
+    std::array<uint32_t, kCells> path{};    // candidate index per depth
+    int depth = 0;
+};
+
+#endif
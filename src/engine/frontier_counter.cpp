@@ -0,0 +1,215 @@
+#include "frontier_counter.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+#include "piece_inventory.h"
+
+namespace {
+
+// Scan index of (x, y): columns of the short side, one after the other.
+class ScanOrder {
+public:
+    ScanOrder(int w, int h) : width(w), height(h), column_major(h <= w) {}
+
+    int operator()(int x, int y) const { return column_major ? x * height + y : y * width + x; }
+
+private:
+    int width, height;
+    bool column_major;
+};
+
+// Calls fn(anchor, relative mask) for every position of `variant` on the
+// board. Returns false (and stops) when a placement spans more than
+// FrontierCounter::kMaxWindow cells.
+template <class Fn>
+bool for_each_position(int w, int h, const std::vector<Cell>& variant, const ScanOrder& order, Fn&& fn) {
+    int min_x = variant[0].x, min_y = variant[0].y, max_x = min_x, max_y = min_y;
+    for (const auto& c : variant) {
+        min_x = std::min(min_x, c.x);
+        min_y = std::min(min_y, c.y);
+        max_x = std::max(max_x, c.x);
+        max_y = std::max(max_y, c.y);
+    }
+    for (int oy = -min_y; oy + max_y < h; ++oy) {
+        for (int ox = -min_x; ox + max_x < w; ++ox) {
+            int anchor = order(variant[0].x + ox, variant[0].y + oy);
+            for (const auto& c : variant) anchor = std::min(anchor, order(c.x + ox, c.y + oy));
+
+            uint32_t mask = 0;
+            for (const auto& c : variant) {
+                const int rel = order(c.x + ox, c.y + oy) - anchor;
+                if (rel >= FrontierCounter::kMaxWindow) return false;
+                mask |= 1u << rel;
+            }
+            fn(anchor, mask);
+        }
+    }
+    return true;
+}
+
+// Open-addressing map from state key to count. ~0 is the empty slot; keys
+// never reach it because the used-count part stays below 2^32 - 1.
+class StateTable {
+public:
+    static constexpr uint64_t kEmpty = ~0ull;
+
+    explicit StateTable(size_t max_states_) : max_states(max_states_) { rehash(64); }
+
+    void add(uint64_t key, uint64_t count) {
+        size_t i = slot(key);
+        while (keys[i] != kEmpty && keys[i] != key) i = (i + 1) & mask;
+        if (keys[i] == key) {
+            counts[i] += count;
+            return;
+        }
+        keys[i] = key;
+        counts[i] = count;
+        if (++used * 4 > keys.size() * 3) {
+            if (used > max_states) throw std::length_error("Frontier state table is full");
+            rehash(keys.size() * 2);
+        }
+    }
+
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] != kEmpty) fn(keys[i], counts[i]);
+        }
+    }
+
+    void clear() {
+        std::fill(keys.begin(), keys.end(), kEmpty);
+        used = 0;
+    }
+
+    size_t size() const { return used; }
+
+private:
+    size_t slot(uint64_t key) const { return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift); }
+
+    void rehash(size_t capacity) {
+        std::vector<uint64_t> old_keys(capacity, kEmpty);
+        std::vector<uint64_t> old_counts(capacity);
+        old_keys.swap(keys);
+        old_counts.swap(counts);
+        mask = capacity - 1;
+        shift = 64 - std::countr_zero(capacity);
+        used = 0;
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == kEmpty) continue;
+            size_t j = slot(old_keys[i]);
+            while (keys[j] != kEmpty) j = (j + 1) & mask;
+            keys[j] = old_keys[i];
+            counts[j] = old_counts[i];
+            ++used;
+        }
+    }
+
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> counts;
+    size_t mask = 0;
+    int shift = 0;
+    size_t used = 0;
+    size_t max_states;
+};
+
+}  // namespace
+
+bool FrontierCounter::supports(int w, int h, const std::vector<Piece>& pieces) {
+    if (!supports(w, h)) return false;
+    const ScanOrder order(w, h);
+    for (const auto& piece : pieces) {
+        for (const auto& variant : piece.get_variants()) {
+            if (!for_each_position(w, h, variant, order, [](int, uint32_t) {})) return false;
+        }
+    }
+    return true;
+}
+
+FrontierCounter::FrontierCounter(int w, int h, const std::vector<Piece>& pieces, size_t max_states_)
+    : cells(w * h), max_states(max_states_) {
+    if (!supports(w, h)) {
+        throw std::invalid_argument("FrontierCounter needs a short side of at most " +
+                                    std::to_string(kMaxShortSide) + ", got " + std::to_string(w) + "x" +
+                                    std::to_string(h));
+    }
+
+    const PieceInventory inventory(pieces);
+    const auto& kinds = inventory.get_kinds();
+    uint64_t place = 1;
+    for (const auto& kind : kinds) {
+        radix.push_back((uint32_t)kind.count + 1);
+        weight.push_back((uint32_t)place);
+        all_used += (uint32_t)(place * kind.count);
+        place *= (uint64_t)kind.count + 1;
+        if (place >= 0xFFFFFFFFull) throw std::invalid_argument("Too many piece kinds for FrontierCounter");
+    }
+
+    // bucket by anchor, kind and variant order inside a bucket
+    std::vector<std::vector<Move>> by_anchor(cells);
+    const ScanOrder order(w, h);
+    for (size_t k = 0; k < kinds.size(); ++k) {
+        for (const auto& variant : kinds[k].piece->get_variants()) {
+            const bool fits = for_each_position(w, h, variant, order, [&](int anchor, uint32_t mask) {
+                by_anchor[anchor].push_back(Move{mask, (uint32_t)k});
+            });
+            if (!fits) {
+                throw std::invalid_argument("Piece " + std::to_string(kinds[k].piece->get_id()) +
+                                            " spans more than " + std::to_string(kMaxWindow) +
+                                            " cells of the frontier");
+            }
+        }
+    }
+    begin.reserve(cells + 1);
+    for (const auto& bucket : by_anchor) {
+        begin.push_back((uint32_t)moves.size());
+        moves.insert(moves.end(), bucket.begin(), bucket.end());
+    }
+    begin.push_back((uint32_t)moves.size());
+}
+
+// key = profile << 32 | used, where profile bit i is scan cell pos + i and
+// used is the mixed-radix count of copies placed per kind
+uint64_t FrontierCounter::count() {
+    peak_states = 0;
+    transitions = 0;
+
+    StateTable current(max_states), next(max_states);
+    current.add(0, 1);
+
+    for (int pos = 0; pos < cells; ++pos) {
+        next.clear();
+        const Move* first = moves.data() + begin[pos];
+        const Move* last = moves.data() + begin[pos + 1];
+
+        current.for_each([&](uint64_t key, uint64_t n) {
+            const uint32_t profile = (uint32_t)(key >> 32);
+            const uint32_t used = (uint32_t)key;
+
+            // already covered by an earlier piece
+            if (profile & 1u) {
+                next.add((uint64_t)(profile >> 1) << 32 | used, n);
+                ++transitions;
+                return;
+            }
+            for (const Move* m = first; m != last; ++m) {
+                if (m->mask & profile) continue;
+                if ((used / weight[m->kind]) % radix[m->kind] + 1 == radix[m->kind]) continue;
+                next.add((uint64_t)((profile | m->mask) >> 1) << 32 | (used + weight[m->kind]), n);
+                ++transitions;
+            }
+        });
+
+        std::swap(current, next);
+        peak_states = std::max(peak_states, current.size());
+    }
+
+    uint64_t total = 0;
+    current.for_each([&](uint64_t key, uint64_t n) {
+        if (key == all_used) total += n;
+    });
+    return total;
+}
@@ -0,0 +1,65 @@
+#ifndef FRONTIER_COUNTER_H
+#define FRONTIER_COUNTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+
+// Solution counting by dynamic programming over the frontier (broken profile).
+// --------------------------------
+// Cells are scanned along the long side, short side first, and every piece
+// is placed at its first cell in that order. The part of the board already
+// decided then only matters through the next `window` cells it has covered
+// (the profile) and the copies of each kind used so far, so partial boards
+// that agree on both are one state with a count instead of separate
+// subtrees. The states of one scan position live in a single hash table;
+// max_states caps its size, and so the memory.
+//
+// Counts the same solutions as Solver::count_solutions: every placement of
+// every variant, with the copies of a repeated piece interchangeable. Any
+// board area works; the short side has to be at most kMaxShortSide and the
+// pieces short enough along the scan that a placement spans at most
+// kMaxWindow cells.
+class FrontierCounter {
+public:
+    static constexpr int kMaxShortSide = 6;
+    static constexpr int kMaxWindow = 32;
+    static constexpr size_t kDefaultMaxStates = size_t(1) << 21;   // tables of at most 64 MiB
+
+    // Throws std::invalid_argument when the board or pieces do not fit (see
+    // supports()).
+    FrontierCounter(int w, int h, const std::vector<Piece>& pieces, size_t max_states = kDefaultMaxStates);
+
+    // Board shape only; the pieces can still be too long for the window.
+    static bool supports(int w, int h) { return w > 0 && h > 0 && std::min(w, h) <= kMaxShortSide; }
+    static bool supports(int w, int h, const std::vector<Piece>& pieces);
+
+    // Throws std::length_error when a scan position has more than max_states
+    // states.
+    uint64_t count();
+
+    size_t get_peak_states() const { return peak_states; }   // largest table of the last count()
+    uint64_t get_transitions() const { return transitions; }
+
+private:
+    class Move {
+    public:
+        uint32_t mask;          // cells covered, relative to the anchor
+        uint32_t kind;
+    };
+
+    int cells = 0;
+    size_t max_states;
+    std::vector<uint32_t> begin;        // moves anchored at each cell: [begin[c], begin[c + 1])
+    std::vector<Move> moves;
+    std::vector<uint32_t> radix;        // copies + 1 per kind
+    std::vector<uint32_t> weight;       // mixed-radix place value of each kind's used count
+    uint32_t all_used = 0;
+
+    size_t peak_states = 0;
+    uint64_t transitions = 0;
+};
+
+#endif
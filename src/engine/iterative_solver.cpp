@@ -0,0 +1,282 @@
+#include "iterative_solver.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+IterativeSolver::IterativeSolver(int w, int h, const std::vector<Piece>& pieces)
+    : table(w, h, pieces), frames(pieces.size() + 1) {
+    piece_ids.reserve(pieces.size());
+    for (const auto& p : pieces) piece_ids.push_back(p.get_id());
+    reset();
+}
+
+void IterativeSolver::reset() {
+    reset(prefilled);
+}
+
+void IterativeSolver::reset(uint64_t prefill) {
+    prefilled = prefill & table.full_mask();
+    piece_left = table.get_inventory().initial_counts();
+    depth = 0;
+    at_solution = false;
+    exhausted = false;
+    stats = SearchStats{};
+    open_frame(0, prefilled);
+}
+
+void IterativeSolver::set_transposition_table(TranspositionTable* table, int min_pieces_left) {
+    memo_min_left = min_pieces_left;
+    const auto counts = this->table.get_inventory().initial_counts();
+    const bool fits = counts.size() <= 16 &&
+                      std::all_of(counts.begin(), counts.end(), [](int c) { return c <= 15; });
+    memo = fits ? table : nullptr;
+}
+
+// copies left per kind, 4 bits each
+uint64_t IterativeSolver::pieces_key() const {
+    uint64_t key = 0;
+    for (size_t i = 0; i < piece_left.size(); ++i) {
+        key |= (uint64_t)piece_left[i] << (4 * i);
+    }
+    return key;
+}
+
+void IterativeSolver::open_frame(int d, uint64_t occupied) {
+    Frame& f = frames[d];
+    f.occupied = occupied;
+    f.nodes_at_open = stats.nodes;
+    f.solutions_at_open = stats.solutions;
+    f.exact = true;
+    if (occupied == table.full_mask()) {
+        f.begin = f.end = f.cursor = 0;
+        return;
+    }
+    const int cell = PlacementTable::first_empty(occupied);
+    f.begin = f.cursor = table.bucket_begin(cell);
+    f.end = table.bucket_end(cell);
+}
+
+void IterativeSolver::pop() {
+    --depth;
+    ++piece_left[table.at(frames[depth].chosen).kind_index];
+}
+
+bool IterativeSolver::solve() {
+    reset();
+    return next() == SearchStatus::Found;
+}
+
+SearchStatus IterativeSolver::next(uint64_t node_budget) {
+    if (exhausted) return SearchStatus::Exhausted;
+    if (at_solution) {
+        at_solution = false;
+        pop();
+    }
+
+    const uint64_t full = table.full_mask();
+    const uint64_t stop_at = node_budget > 0 ? stats.nodes + node_budget : UINT64_MAX;
+
+    while (true) {
+        Frame& f = frames[depth];
+
+        bool placed = false;
+        while (f.cursor < f.end) {
+            const uint32_t k = f.cursor++;
+            const TablePlacement& p = table.at(k);
+            ++stats.placement_tests;
+            if (piece_left[p.kind_index] == 0 || (p.mask & f.occupied)) continue;
+
+            const uint64_t occupied = f.occupied | p.mask;
+            --piece_left[p.kind_index];
+
+            // known dead state: skip the placement
+            uint64_t known;
+            const int left = (int)frames.size() - 2 - depth;
+            if (memo && left >= memo_min_left && occupied != full &&
+                memo->probe(occupied, pieces_key(), known) && known == 0) {
+                ++piece_left[p.kind_index];
+                continue;
+            }
+
+            f.chosen = k;
+            ++depth;
+            ++stats.nodes;
+
+            if (occupied == full) {
+                at_solution = true;
+                ++stats.solutions;
+                return SearchStatus::Found;
+            }
+            open_frame(depth, occupied);
+            placed = true;
+            break;
+        }
+
+        if (placed) {
+            if (stats.nodes >= stop_at) return SearchStatus::Paused;
+            continue;
+        }
+
+        // every candidate at this depth failed -> backtrack
+        if (depth == 0) {
+            exhausted = true;
+            return SearchStatus::Exhausted;
+        }
+        if (memo && f.exact && (int)frames.size() - 1 - depth >= memo_min_left) {
+            memo->store(f.occupied, pieces_key(), stats.solutions - f.solutions_at_open,
+                        stats.nodes - f.nodes_at_open);
+        }
+        pop();
+    }
+}
+
+uint64_t IterativeSolver::count_solutions(uint64_t limit) {
+    reset();
+    if (memo) {
+        uint64_t total = 0;
+        count_memo(prefilled, (int)frames.size() - 1, total, limit);
+        stats.solutions = total;
+        return limit > 0 ? std::min(total, limit) : total;
+    }
+
+    uint64_t count = 0;
+    while (next() == SearchStatus::Found) {
+        ++count;
+        if (limit > 0 && count >= limit) break;
+    }
+    return count;
+}
+
+uint64_t IterativeSolver::enumerate(SolutionSink& sink, uint64_t limit) {
+    reset();
+    std::vector<uint16_t> decisions(frames.size() - 1);
+    uint64_t count = 0;
+    while (next() == SearchStatus::Found) {
+        for (int d = 0; d < depth; ++d) decisions[d] = (uint16_t)(frames[d].chosen - frames[d].begin);
+        sink.on_solution(decisions.data(), (size_t)depth);
+        ++count;
+        if (limit > 0 && count >= limit) break;
+    }
+    return count;
+}
+
+// Recursive count that adds memoized subtrees instead of walking them again.
+// Returns the solutions below `occupied`; a subtree cut short by the limit is
+// not stored.
+uint64_t IterativeSolver::count_memo(uint64_t occupied, int left, uint64_t& total, uint64_t limit) {
+    if (occupied == table.full_mask()) {
+        ++total;
+        return 1;
+    }
+
+    const bool use_memo = left >= memo_min_left;
+    const uint64_t key = use_memo ? pieces_key() : 0;
+    uint64_t known;
+    if (use_memo && memo->probe(occupied, key, known)) {
+        total += known;
+        return known;
+    }
+
+    const uint64_t nodes_before = stats.nodes;
+    const int cell = PlacementTable::first_empty(occupied);
+    uint64_t count = 0;
+
+    for (uint32_t k = table.bucket_begin(cell); k < table.bucket_end(cell); ++k) {
+        const TablePlacement& p = table.at(k);
+        ++stats.placement_tests;
+        if (piece_left[p.kind_index] == 0 || (p.mask & occupied)) continue;
+
+        --piece_left[p.kind_index];
+        ++stats.nodes;
+        count += count_memo(occupied | p.mask, left - 1, total, limit);
+        ++piece_left[p.kind_index];
+
+        if (limit > 0 && total >= limit) return count;
+    }
+
+    if (use_memo) memo->store(occupied, key, count, stats.nodes - nodes_before);
+    return count;
+}
+
+std::vector<Placement> IterativeSolver::get_placements_path() const {
+    std::vector<Placement> out;
+    out.reserve(depth);
+    for (int d = 0; d < depth; ++d) {
+        out.push_back(table.to_placement(frames[d].chosen));
+    }
+    return out;
+}
+
+std::vector<uint16_t> IterativeSolver::get_decisions() const {
+    std::vector<uint16_t> out;
+    out.reserve(depth);
+    for (int d = 0; d < depth; ++d) {
+        out.push_back((uint16_t)(frames[d].chosen - frames[d].begin));
+    }
+    return out;
+}
+
+SearchCheckpoint IterativeSolver::checkpoint() const {
+    SearchCheckpoint cp;
+    cp.width = table.get_width();
+    cp.height = table.get_height();
+    cp.piece_ids = piece_ids;
+    cp.decisions = get_decisions();
+    cp.next = at_solution ? 0 : (uint16_t)(frames[depth].cursor - frames[depth].begin);
+    cp.at_solution = at_solution;
+    cp.exhausted = exhausted;
+    cp.piece_left.assign(piece_left.begin(), piece_left.end());
+    cp.nodes = stats.nodes;
+    cp.solutions = stats.solutions;
+    return cp;
+}
+
+void IterativeSolver::resume(const SearchCheckpoint& cp) {
+    if (cp.width != table.get_width() || cp.height != table.get_height() || cp.piece_ids != piece_ids) {
+        throw std::invalid_argument("Checkpoint belongs to a different puzzle instance");
+    }
+    if (cp.decisions.size() >= frames.size()) {
+        throw std::invalid_argument("Checkpoint is deeper than the piece count");
+    }
+
+    reset();
+    for (uint16_t decision : cp.decisions) {
+        Frame& f = frames[depth];
+        const uint32_t k = f.begin + decision;
+        if (k >= f.end) {
+            throw std::invalid_argument("Checkpoint decision out of range");
+        }
+        const TablePlacement& p = table.at(k);
+        if (piece_left[p.kind_index] == 0 || (p.mask & f.occupied)) {
+            throw std::invalid_argument("Checkpoint decision does not fit the board");
+        }
+        --piece_left[p.kind_index];
+        f.chosen = k;
+        f.cursor = k + 1;
+        ++depth;
+        open_frame(depth, f.occupied | p.mask);
+    }
+
+    const bool full = frames[depth].occupied == table.full_mask();
+    if (cp.at_solution != full) {
+        throw std::invalid_argument("Checkpoint solution flag does not match the board");
+    }
+    if (!cp.at_solution) {
+        Frame& top = frames[depth];
+        if (top.begin + cp.next > top.end) {
+            throw std::invalid_argument("Checkpoint cursor out of range");
+        }
+        top.cursor = top.begin + cp.next;
+    }
+    if (std::vector<uint8_t>(piece_left.begin(), piece_left.end()) != cp.piece_left) {
+        throw std::invalid_argument("Checkpoint used-piece counts do not match its decisions");
+    }
+
+    // solutions found before the checkpoint are not in these frames' counters
+    for (int d = 0; d <= depth; ++d) frames[d].exact = false;
+
+    at_solution = cp.at_solution;
+    exhausted = cp.exhausted;
+    stats.nodes = cp.nodes;
+    stats.solutions = cp.solutions;
+}
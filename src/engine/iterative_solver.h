@@ -0,0 +1,102 @@
+#ifndef ITERATIVE_SOLVER_H
+#define ITERATIVE_SOLVER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "placement_table.h"
+#include "search_checkpoint.h"
+#include "search_stats.h"
+#include "solution_sink.h"
+#include "transposition_table.h"
+
+enum class SearchStatus {
+    Found,      // a solution is ready in get_placements_path()
+    Exhausted,  // no more solutions
+    Paused,     // node budget used up; call next() again or checkpoint()
+};
+
+// Explicit-stack version of the search (boards of at most 64 cells).
+// --------------------------------
+// Same order as Solver::dfs, but all state lives in a small frame array
+// instead of the call stack, so the search can stop after any node, hand out
+// solutions one at a time, and be saved with checkpoint() / resume().
+class IterativeSolver {
+public:
+    // Throws std::invalid_argument when the board has more than 64 cells.
+    IterativeSolver(int w, int h, const std::vector<Piece>& pieces);
+
+    void reset();
+
+    // Start over from a board whose `prefilled` cells are already covered by
+    // pieces this solver does not own (e.g. a player's partial board). The
+    // mask is kept for later reset() / resume() calls; checkpoints do not
+    // record it, so resume into a solver with the same prefill.
+    void reset(uint64_t prefilled);
+
+    // First solution from the start.
+    bool solve();
+
+    // Continue to the next solution. node_budget > 0 pauses after that many
+    // placements.
+    SearchStatus next(uint64_t node_budget = 0);
+
+    uint64_t count_solutions(uint64_t limit = 0);
+
+    // Every solution from the start into `sink`, in search order (limit > 0
+    // stops after that many). Returns how many were delivered.
+    uint64_t enumerate(SolutionSink& sink, uint64_t limit = 0);
+
+    std::vector<Placement> get_placements_path() const;
+    std::vector<uint16_t> get_decisions() const;
+
+    SearchCheckpoint checkpoint() const;
+
+    // Throws std::invalid_argument if the checkpoint is for another instance
+    // or does not replay on this board.
+    void resume(const SearchCheckpoint& cp);
+
+    // Optional memo of dead states and subtree counts (nullptr = off). The
+    // table must only hold states of this instance; see TranspositionTable.
+    // States with fewer than min_pieces_left pieces to place are not looked
+    // up: their subtrees are cheaper to search than a table probe.
+    // Ignored when a kind has more than 15 copies or there are over 16 kinds.
+    void set_transposition_table(TranspositionTable* table, int min_pieces_left = 3);
+
+    const SearchStats& get_stats() const { return stats; }
+    const PlacementTable& get_table() const { return table; }
+
+private:
+    struct Frame {
+        uint64_t occupied;  // board before this depth's placement
+        uint32_t begin;     // anchor bucket
+        uint32_t end;
+        uint32_t cursor;    // next candidate to try
+        uint32_t chosen;    // candidate placed at this depth
+        uint64_t nodes_at_open;
+        uint64_t solutions_at_open;
+        bool exact;         // explored from its first candidate (not resumed)
+    };
+
+    void open_frame(int d, uint64_t occupied);
+    void pop();
+
+    uint64_t pieces_key() const;
+    uint64_t count_memo(uint64_t occupied, int left, uint64_t& total, uint64_t limit);
+
+    PlacementTable table;
+    std::vector<int> piece_ids;
+    std::vector<int> piece_left;
+
+    std::vector<Frame> frames;      // piece count + 1
+    int depth = 0;
+    uint64_t prefilled = 0;
+    bool at_solution = false;
+    bool exhausted = false;
+
+    SearchStats stats;
+    TranspositionTable* memo = nullptr;
+    int memo_min_left = 0;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "kernel_dispatch.h"
+#include "fixed_solver.h"
+
+template <int W, int H>
+static bool solve_fixed(const std::vector<Piece>& pieces, std::vector<Placement>& path) {
+    FixedSolver<W, H> solver(pieces);
+    if (!solver.solve()) return false;
+    path = solver.get_placements_path();
+    return true;
+}
+
+template <int W, int H>
+static uint64_t count_fixed(const std::vector<Piece>& pieces, uint64_t limit) {
+    FixedSolver<W, H> solver(pieces);
+    return solver.count_solutions(limit);
+}
+
+template <int W, int H>
+static constexpr SolverKernel kernel() {
+    return SolverKernel{W, H, &solve_fixed<W, H>, &count_fixed<W, H>};
+}
+
+// Shapes used by levels/ (width x height as written in the level files) plus
+// their transposes and the classic pentomino rectangles.
+const std::vector<SolverKernel>& all_kernels() {
+    static const std::vector<SolverKernel> kernels = {
+        kernel<3, 5>(),  kernel<5, 3>(),
+        kernel<4, 5>(),  kernel<5, 4>(),
+        kernel<5, 5>(),
+        kernel<6, 5>(),  kernel<5, 6>(),
+        kernel<7, 5>(),  kernel<5, 7>(),
+        kernel<8, 5>(),  kernel<5, 8>(),
+        kernel<9, 5>(),  kernel<5, 9>(),
+        kernel<10, 5>(), kernel<5, 10>(),
+        kernel<11, 5>(), kernel<5, 11>(),
+        kernel<12, 5>(), kernel<5, 12>(),
+        kernel<10, 6>(), kernel<6, 10>(),
+        kernel<15, 4>(), kernel<4, 15>(),
+        kernel<20, 3>(), kernel<3, 20>(),
+    };
+    return kernels;
+}
+
+const SolverKernel* find_kernel(int width, int height) {
+    for (const auto& k : all_kernels()) {
+        if (k.width == width && k.height == height) return &k;
+    }
+    return nullptr;
+}
@@ -0,0 +1,29 @@
+#ifndef KERNEL_DISPATCH_H
+#define KERNEL_DISPATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+#include "placement.h"
+
+// Runtime dispatch to FixedSolver<W, H> for the board shapes we ship.
+// --------------------------------
+// find_kernel() returns nullptr for any other size; callers then fall back to
+// the generic Solver.
+struct SolverKernel {
+    int width;
+    int height;
+
+    // first solution; fills path (piece ids, variant, offset) on success
+    bool (*solve)(const std::vector<Piece>& pieces, std::vector<Placement>& path);
+
+    // number of solutions, stopping at limit when limit > 0
+    uint64_t (*count)(const std::vector<Piece>& pieces, uint64_t limit);
+};
+
+const SolverKernel* find_kernel(int width, int height);
+
+const std::vector<SolverKernel>& all_kernels();
+
+#endif
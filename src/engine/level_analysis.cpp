@@ -0,0 +1,127 @@
+#include "level_analysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "feasibility.h"
+#include "iterative_solver.h"
+#include "placement_table.h"
+
+// The b for which a uniform tree of the given depth has `nodes` nodes below
+// its root. Bisection: the sum is increasing in b.
+static double effective_branching(uint64_t nodes, int depth) {
+    if (nodes == 0 || depth <= 0) return 0;
+    auto tree = [depth](double b) {
+        double sum = 0, level = 1;
+        for (int d = 0; d < depth; ++d) sum += (level *= b);
+        return sum;
+    };
+    double lo = 0, hi = (double)nodes;
+    for (int i = 0; i < 100; ++i) {
+        const double mid = (lo + hi) / 2;
+        if (tree(mid) < (double)nodes) lo = mid; else hi = mid;
+    }
+    return (lo + hi) / 2;
+}
+
+LevelAnalyzer::LevelAnalyzer(int w, int h, std::vector<Piece> pieces_, uint64_t limit_)
+    : width(w), height(h), pieces(std::move(pieces_)), limit(limit_) {
+    const PlacementTable table(width, height, pieces);
+    full = table.full_mask();
+
+    FeasibilityReport report = check_feasibility(width, height, pieces);
+    if (!report.feasible) {
+        infeasible = report.reason;
+        return;
+    }
+
+    const auto& kinds = table.get_inventory().get_kinds();
+    for (uint32_t k = table.bucket_begin(0); k < table.bucket_end(0); ++k) {
+        const TablePlacement& p = table.at(k);
+        roots.push_back(Root{kinds[p.kind_index].piece->get_id(), p.mask});
+    }
+}
+
+BranchStats LevelAnalyzer::run_branch(size_t index) const {
+    const auto start = std::chrono::steady_clock::now();
+    const Root& root = roots.at(index);
+    BranchStats out;
+
+    if (root.mask == full) {
+        out.solutions = 1;
+        return out;
+    }
+
+    // Drop the last copy of the root piece: kinds keep their order of first
+    // appearance, so the sub-search tries candidates in the same order as
+    // the full search would below this root.
+    std::vector<Piece> rest = pieces;
+    for (size_t i = rest.size(); i-- > 0;) {
+        if (rest[i].get_id() == root.piece_id) {
+            rest.erase(rest.begin() + (std::ptrdiff_t)i);
+            break;
+        }
+    }
+
+    IterativeSolver solver(width, height, rest);
+    solver.reset(root.mask);
+
+    SearchStatus status;
+    while ((status = solver.next()) == SearchStatus::Found) {
+        if (solver.get_stats().solutions == 1) out.nodes_to_first = solver.get_stats().nodes;
+        if (limit > 0 && solver.get_stats().solutions >= limit) break;
+    }
+
+    const SearchStats& s = solver.get_stats();
+    out.nodes = s.nodes;
+    out.solutions = s.solutions;
+    out.complete = status == SearchStatus::Exhausted;
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
+LevelAnalysis LevelAnalyzer::combine(const std::vector<BranchStats>& results) const {
+    LevelAnalysis a;
+    if (!infeasible.empty()) {
+        a.feasible = false;
+        a.reason = infeasible;
+        return a;
+    }
+
+    for (const auto& b : results) {
+        if (!a.solvable && b.solutions > 0) {
+            a.solvable = true;
+            a.nodes_to_first = a.nodes + 1 + b.nodes_to_first;
+        }
+        a.nodes += 1 + b.nodes;
+        a.solution_count += b.solutions;
+        a.complete = a.complete && b.complete;
+        a.seconds += b.seconds;
+    }
+    if (limit > 0 && a.solution_count > limit) {
+        a.solution_count = limit;
+        a.complete = false;
+    }
+    a.branching = effective_branching(a.nodes, (int)pieces.size());
+    return a;
+}
+
+LevelAnalysis LevelAnalyzer::run() const {
+    std::vector<BranchStats> results;
+    results.reserve(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) results.push_back(run_branch(i));
+    return combine(results);
+}
+
+double LevelAnalysis::difficulty_score() const {
+    if (!solvable || solution_count == 0) return 0;
+    return std::log10((double)nodes / (double)solution_count);
+}
+
+int LevelAnalysis::difficulty() const {
+    if (!solvable) return 0;
+    static constexpr double kBounds[] = {1.5, 2.5, 3.25, 3.75};
+    const double score = difficulty_score();
+    return 1 + (int)(std::upper_bound(std::begin(kBounds), std::end(kBounds), score) - std::begin(kBounds));
+}
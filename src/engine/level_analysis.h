@@ -0,0 +1,81 @@
+#ifndef LEVEL_ANALYSIS_H
+#define LEVEL_ANALYSIS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "piece.h"
+
+// Search statistics of one level, for the level_analyzer tool.
+// --------------------------------
+// The work is split into branches: one per placement that can cover the
+// first cell (the root bucket of the PlacementTable). Each branch is the
+// subtree a sequential search would explore after that first placement, so
+// branches run independently on any thread, and combine() adds them up in
+// bucket order to give the same numbers as one sequential search.
+//
+// Boards of at most 64 cells.
+class BranchStats {
+public:
+    uint64_t nodes = 0;             // placements below the root placement
+    uint64_t solutions = 0;
+    uint64_t nodes_to_first = 0;    // placements up to the first solution, if found
+    bool complete = true;           // false when the solution limit stopped it
+    double seconds = 0;
+};
+
+class LevelAnalysis {
+public:
+    bool feasible = true;
+    std::string reason;             // from check_feasibility when !feasible
+    bool solvable = false;
+    uint64_t solution_count = 0;
+    bool complete = true;           // solution_count is exact
+    uint64_t nodes_to_first = 0;    // placements before the first solution (incl. its own)
+    uint64_t nodes = 0;             // placements of the whole search
+    double branching = 0;           // effective branching factor b: b + b^2 + ... + b^pieces = nodes
+    double seconds = 0;             // search time summed over branches
+
+    // log10 of the placements searched per solution: how rare solutions are
+    // among the partial boards a player could build. 0 when unsolvable.
+    double difficulty_score() const;
+
+    // difficulty_score() bucketed to 1 (easy) .. 5 (hard); 0 when unsolvable.
+    int difficulty() const;
+};
+
+class LevelAnalyzer {
+public:
+    // Throws std::invalid_argument when the board has more than 64 cells.
+    // limit > 0 stops each branch after that many solutions.
+    LevelAnalyzer(int w, int h, std::vector<Piece> pieces, uint64_t limit = 0);
+
+    // 0 when the level fails check_feasibility.
+    size_t branch_count() const { return roots.size(); }
+
+    // Thread-safe: every call builds its own solver.
+    BranchStats run_branch(size_t index) const;
+
+    // results[i] from run_branch(i), for every branch.
+    LevelAnalysis combine(const std::vector<BranchStats>& results) const;
+
+    // All branches on the calling thread.
+    LevelAnalysis run() const;
+
+private:
+    class Root {
+    public:
+        int piece_id;
+        uint64_t mask;
+    };
+
+    int width, height;
+    std::vector<Piece> pieces;
+    uint64_t limit;
+    uint64_t full = 0;
+    std::string infeasible;
+    std::vector<Root> roots;    // root bucket, in search order
+};
+
+#endif
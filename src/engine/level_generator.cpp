@@ -0,0 +1,136 @@
+#include "level_generator.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "feasibility.h"
+#include "iterative_solver.h"
+#include "kernel_dispatch.h"
+#include "level_analysis.h"
+#include "piece_library.h"
+#include "placement_table.h"
+#include "solution_count.h"
+
+namespace {
+
+// splitmix64: cheap, and any (seed, index) pair gives an independent stream
+class SplitMix {
+public:
+    explicit SplitMix(uint64_t state) : state(state) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // [lo, hi]
+    int between(int lo, int hi) { return lo + (int)(next() % (uint64_t)(hi - lo + 1)); }
+
+private:
+    uint64_t state;
+};
+
+}  // namespace
+
+const char* to_string(CandidateVerdict v) {
+    switch (v) {
+        case CandidateVerdict::Accepted:   return "accepted";
+        case CandidateVerdict::NoBoard:    return "no_board";
+        case CandidateVerdict::Infeasible: return "infeasible";
+        case CandidateVerdict::Unsolvable: return "unsolvable";
+        case CandidateVerdict::NotUnique:  return "not_unique";
+        case CandidateVerdict::OutOfBand:  return "out_of_band";
+    }
+    return "unknown";
+}
+
+LevelGenerator::LevelGenerator(const GeneratorConstraints& constraints, uint64_t seed_)
+    : limits(constraints), seed(seed_), library(PieceLibrary::make_all_pieces()) {
+    if (limits.min_pieces < 1 || limits.max_pieces > (int)library.size() || limits.min_pieces > limits.max_pieces) {
+        throw std::invalid_argument("Piece count range must be inside 1.." + std::to_string(library.size()));
+    }
+    if (limits.min_difficulty > limits.max_difficulty) {
+        throw std::invalid_argument("Empty difficulty band");
+    }
+}
+
+int LevelGenerator::board_symmetries(int width, int height) {
+    return width == height ? 8 : 4;
+}
+
+LevelCandidate LevelGenerator::sample(uint64_t index) const {
+    SplitMix rng(seed * 0xD1B54A32D192ED03ull + index);
+
+    LevelCandidate c;
+    c.index = index;
+
+    // k distinct pieces: partial Fisher-Yates over the library
+    const int k = rng.between(limits.min_pieces, limits.max_pieces);
+    std::vector<int> ids(library.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    for (int i = 0; i < k; ++i) std::swap(ids[i], ids[rng.between(i, (int)ids.size() - 1)]);
+    ids.resize(k);
+    std::sort(ids.begin(), ids.end());
+    c.piece_ids = ids;
+
+    int area = 0;
+    for (int id : ids) area += (int)library[id].get_shape().size();
+
+    if (limits.height > 0) {
+        if (area % limits.height == 0) {
+            c.width = area / limits.height;
+            c.height = limits.height;
+        }
+        return c;
+    }
+
+    std::vector<std::pair<int, int>> boards;
+    for (int h = 3; h * h <= area; ++h) {
+        if (area % h == 0) boards.emplace_back(area / h, h);
+    }
+    if (!boards.empty()) {
+        const auto& b = boards[rng.between(0, (int)boards.size() - 1)];
+        c.width = b.first;
+        c.height = b.second;
+    }
+    return c;
+}
+
+CandidateVerdict LevelGenerator::check(LevelCandidate& c) const {
+    if (c.width <= 0 || !PlacementTable::supports(c.width, c.height)) return CandidateVerdict::NoBoard;
+
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(c.piece_ids);
+    if (!check_feasibility(c.width, c.height, pieces).feasible) return CandidateVerdict::Infeasible;
+
+    const SolverKernel* kernel = find_kernel(c.width, c.height);
+    if (kernel) {
+        std::vector<Placement> path;
+        if (!kernel->solve(pieces, path)) return CandidateVerdict::Unsolvable;
+    } else {
+        IterativeSolver solver(c.width, c.height, pieces);
+        if (!solver.solve()) return CandidateVerdict::Unsolvable;
+    }
+
+    const uint64_t unique_count = (uint64_t)board_symmetries(c.width, c.height);
+
+    if (band_needed()) {
+        LevelAnalysis a = LevelAnalyzer(c.width, c.height, pieces).run();
+        c.solutions = a.solution_count;
+        c.difficulty = a.difficulty();
+        if (limits.unique && c.solutions > unique_count) return CandidateVerdict::NotUnique;
+        if (c.difficulty < limits.min_difficulty || c.difficulty > limits.max_difficulty) {
+            return CandidateVerdict::OutOfBand;
+        }
+        return CandidateVerdict::Accepted;
+    }
+
+    if (limits.unique) {
+        // one past the symmetric copies is enough to reject
+        c.solutions = count_level_solutions(c.width, c.height, pieces, unique_count + 1).count;
+        if (c.solutions > unique_count) return CandidateVerdict::NotUnique;
+    }
+    return CandidateVerdict::Accepted;
+}
@@ -0,0 +1,77 @@
+#ifndef LEVEL_GENERATOR_H
+#define LEVEL_GENERATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+
+// Random level candidates and the checks that filter them.
+// --------------------------------
+// A candidate is a set of distinct PieceLibrary pieces and a board whose area
+// is exactly theirs. Candidate i is a pure function of (seed, i), so several
+// threads can check different indices and the accepted set does not depend on
+// the thread count.
+//
+// check() runs the filters cheapest first and stops at the first rejection:
+//   1. check_feasibility (fit, checkerboard parity, coverage): microseconds
+//   2. first solution with the fastest engine for the size (FixedSolver
+//      kernel if one exists, else IterativeSolver)
+//   3. only when asked for: unique solution (up to the board's symmetries),
+//      then the LevelAnalyzer difficulty band
+class GeneratorConstraints {
+public:
+    int min_pieces = 3;
+    int max_pieces = 8;
+    int height = 5;             // fixed, like the catalogue; 0 = any board with both sides >= 3
+    int min_difficulty = 1;     // LevelAnalysis::difficulty() band
+    int max_difficulty = 5;
+    bool unique = false;
+};
+
+class LevelCandidate {
+public:
+    uint64_t index = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids; // sorted
+    uint64_t solutions = 0;     // when counted (unique / difficulty checks)
+    int difficulty = 0;         // when analysed
+};
+
+enum class CandidateVerdict {
+    Accepted,
+    NoBoard,        // no board of that area fits the constraints
+    Infeasible,
+    Unsolvable,
+    NotUnique,
+    OutOfBand,
+};
+
+const char* to_string(CandidateVerdict v);
+
+class LevelGenerator {
+public:
+    // Throws std::invalid_argument when the piece range is outside 1..12 or
+    // the difficulty band is empty.
+    LevelGenerator(const GeneratorConstraints& constraints, uint64_t seed);
+
+    // Same (seed, index) -> same candidate. Thread-safe.
+    LevelCandidate sample(uint64_t index) const;
+
+    // Fills solutions / difficulty when it computed them. Thread-safe.
+    CandidateVerdict check(LevelCandidate& c) const;
+
+    // The board's symmetries that keep its shape: 8 for a square, else 4.
+    // A uniquely solvable level has exactly that many solutions, barring a
+    // tiling that is itself symmetric.
+    static int board_symmetries(int width, int height);
+
+private:
+    GeneratorConstraints limits;
+    uint64_t seed;
+    std::vector<Piece> library;
+    bool band_needed() const { return limits.min_difficulty > 1 || limits.max_difficulty < 5; }
+};
+
+#endif
@@ -0,0 +1,147 @@
+#include "perf_counters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* to_string(PerfEvent e) {
+    switch (e) {
+        case PerfEvent::Cycles: return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::L1dMisses: return "l1dMisses";
+        case PerfEvent::LlcMisses: return "llcMisses";
+        case PerfEvent::BranchMisses: return "branchMisses";
+        case PerfEvent::TaskClock: return "taskClockNs";
+    }
+    return "?";
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        available[i] = available[i] || other.available[i];
+        value[i] += other.value[i];
+    }
+    return *this;
+}
+
+#ifdef __linux__
+
+static int open_event(PerfEvent e) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    auto cache_miss = [](uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    switch (e) {
+        case PerfEvent::Cycles: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PerfEvent::Instructions: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PerfEvent::BranchMisses: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case PerfEvent::L1dMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache_miss(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case PerfEvent::LlcMisses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cache_miss(PERF_COUNT_HW_CACHE_LL);
+            break;
+        case PerfEvent::TaskClock:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_TASK_CLOCK;
+            break;
+    }
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        fds[i] = open_event((PerfEvent)i);
+        if (fds[i] < 0 && why.empty()) {
+            why = std::string(to_string((PerfEvent)i)) + ": " + std::strerror(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfSample PerfCounters::stop() {
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    PerfSample s;
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        uint64_t v[3];  // value, time enabled, time running
+        if (fds[i] < 0 || read(fds[i], v, sizeof(v)) != (ssize_t)sizeof(v)) continue;
+        s.available[i] = true;
+        s.value[i] = v[2] > 0 && v[2] < v[1] ? (uint64_t)((double)v[0] * v[1] / v[2]) : v[0];
+    }
+    return s;
+}
+
+#else
+
+PerfCounters::PerfCounters() : why("perf_event_open needs Linux") {
+    fds.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfSample PerfCounters::stop() {
+    return PerfSample{};
+}
+
+#endif
+
+bool PerfCounters::available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+bool PerfCounters::hardware_available() const {
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if ((PerfEvent)i != PerfEvent::TaskClock && fds[i] >= 0) return true;
+    }
+    return false;
+}
+
+double PerfReport::per_node(PerfEvent e) const {
+    return sample.has(e) && stats.nodes > 0 ? (double)sample.get(e) / (double)stats.nodes : 0.0;
+}
+
+double PerfReport::per_test(PerfEvent e) const {
+    return sample.has(e) && stats.placement_tests > 0 ? (double)sample.get(e) / (double)stats.placement_tests : 0.0;
+}
+
+double PerfReport::ipc() const {
+    if (!sample.has(PerfEvent::Cycles) || !sample.has(PerfEvent::Instructions)) return 0;
+    const uint64_t cycles = sample.get(PerfEvent::Cycles);
+    return cycles > 0 ? (double)sample.get(PerfEvent::Instructions) / (double)cycles : 0.0;
+}
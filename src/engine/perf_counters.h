@@ -0,0 +1,75 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "search_stats.h"
+
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    L1dMisses,          // L1 data cache read misses
+    LlcMisses,          // last-level cache read misses
+    BranchMisses,
+    TaskClock,          // software: ns on CPU, works where hardware counters do not
+};
+
+constexpr int kPerfEventCount = 6;
+
+const char* to_string(PerfEvent e);
+
+class PerfSample {
+public:
+    std::array<bool, kPerfEventCount> available{};
+    std::array<uint64_t, kPerfEventCount> value{};  // scaled up when the kernel multiplexed
+
+    bool has(PerfEvent e) const { return available[(int)e]; }
+    uint64_t get(PerfEvent e) const { return value[(int)e]; }
+
+    PerfSample& operator+=(const PerfSample& other);
+};
+
+// Hardware counters of the calling thread around a piece of work (Linux).
+// --------------------------------
+// Each event is opened on its own with perf_event_open (user space only),
+// so a CPU or VM that lacks one event still reports the others. When none
+// opens (no PMU in the VM, perf_event_paranoid, seccomp in containers, not
+// Linux) available() is false and reason() says why; start()/stop() then do
+// nothing and stop() returns an empty sample. Never throws.
+//
+// Only the calling thread is counted: wrap single-threaded solves.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;
+    bool hardware_available() const;    // any event except TaskClock
+    const std::string& reason() const { return why; }  // first open error
+
+    void start();
+    PerfSample stop();
+
+private:
+    std::array<int, kPerfEventCount> fds;
+    std::string why;
+};
+
+// Counters normalized by the search's own counters, for reports.
+class PerfReport {
+public:
+    PerfSample sample;
+    SearchStats stats;              // nodes == 0: the engine does not count its search
+
+    // value / nodes (or / placement tests); 0 when either is missing.
+    double per_node(PerfEvent e) const;
+    double per_test(PerfEvent e) const;
+    double ipc() const;             // instructions per cycle
+};
+
+#endif
@@ -0,0 +1,28 @@
+#include "piece_inventory.h"
+
+PieceInventory::PieceInventory(const std::vector<Piece>& pieces) {
+    for (const auto& piece : pieces) {
+        ++total;
+
+        bool found = false;
+        for (auto& kind : kinds) {
+            if (kind.piece->get_id() == piece.get_id()) {
+                ++kind.count;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            kinds.push_back(PieceKind{&piece, 1});
+        }
+    }
+}
+
+std::vector<int> PieceInventory::initial_counts() const {
+    std::vector<int> counts;
+    counts.reserve(kinds.size());
+    for (const auto& kind : kinds) {
+        counts.push_back(kind.count);
+    }
+    return counts;
+}
@@ -0,0 +1,36 @@
+#ifndef PIECE_INVENTORY_H
+#define PIECE_INVENTORY_H
+
+#include <vector>
+#include "piece.h"
+
+// A level's pieces as (shape, count) pairs.
+// --------------------------------
+// Levels may repeat a piece id. Treating the copies as distinct pieces makes
+// the search try every permutation of them (k! times the work for k copies),
+// so the solvers branch once per kind and only track how many are left.
+//
+// Kinds keep the order of first appearance, so a level without repeats gives
+// exactly the original piece order. Pieces are grouped by id; the pointers
+// refer into the vector given to the constructor.
+struct PieceKind {
+    const Piece* piece;
+    int count;
+};
+
+class PieceInventory {
+public:
+    explicit PieceInventory(const std::vector<Piece>& pieces);
+
+    const std::vector<PieceKind>& get_kinds() const { return kinds; }
+    size_t kind_count() const { return kinds.size(); }
+    int piece_count() const { return total; }
+
+    std::vector<int> initial_counts() const;
+
+private:
+    std::vector<PieceKind> kinds;
+    int total = 0;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "placement_table.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+PlacementTable::PlacementTable(int w, int h, const std::vector<Piece>& pieces)
+    : width(w), height(h), inventory(pieces) {
+    if (!supports(w, h)) {
+        throw std::invalid_argument("PlacementTable supports at most 64 cells, got " +
+                                    std::to_string(w) + "x" + std::to_string(h));
+    }
+    const int cells = w * h;
+    full = cells == 64 ? ~0ull : ((1ull << cells) - 1);
+    begin.assign(cells + 1, 0);
+
+    const auto& kinds = inventory.get_kinds();
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            begin[y * w + x] = (uint32_t)placements.size();
+
+            for (size_t i = 0; i < kinds.size(); ++i) {
+                const auto& variants = kinds[i].piece->get_variants();
+                for (size_t v = 0; v < variants.size(); ++v) {
+                    const auto& variant = variants[v];
+                    const Cell offset{x - variant[0].x, y - variant[0].y};
+
+                    uint64_t mask = 0;
+                    bool fits = true;
+                    for (const auto& c : variant) {
+                        const int px = c.x + offset.x, py = c.y + offset.y;
+                        if (px < 0 || px >= w || py < 0 || py >= h) {
+                            fits = false;
+                            break;
+                        }
+                        mask |= 1ull << (py * w + px);
+                    }
+                    if (fits) {
+                        placements.push_back(TablePlacement{mask, (int)i, (int)v, offset});
+                    }
+                }
+            }
+        }
+    }
+    begin[cells] = (uint32_t)placements.size();
+}
+
+uint32_t PlacementTable::largest_bucket() const {
+    uint32_t best = 0;
+    for (int c = 0; c < cell_count(); ++c) {
+        best = std::max(best, bucket_end(c) - bucket_begin(c));
+    }
+    return best;
+}
+
+Placement PlacementTable::to_placement(uint32_t index) const {
+    const TablePlacement& p = placements[index];
+    return Placement(inventory.get_kinds()[p.kind_index].piece->get_id(), p.variant_index, p.offset);
+}
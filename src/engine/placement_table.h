@@ -0,0 +1,66 @@
+#ifndef PLACEMENT_TABLE_H
+#define PLACEMENT_TABLE_H
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+#include "piece_inventory.h"
+#include "placement.h"
+
+// Every legal placement on a board of at most 64 cells, as occupancy masks.
+// --------------------------------
+// Placements are bucketed by their anchor: the first (row-major) cell they
+// cover. When the search fills the first empty cell, only that cell's bucket
+// can be used. Inside a bucket the order is kind, then variant, which is the
+// order Solver::dfs tries them in.
+//
+// A "decision" is an index relative to the bucket start. Given the cells
+// filled so far the anchor is known, so a solution is just a short list of
+// small decision numbers.
+class TablePlacement {
+public:
+    uint64_t mask;
+    int kind_index;         // into PieceInventory::get_kinds()
+    int variant_index;
+    Cell offset;
+};
+
+class PlacementTable {
+public:
+    static constexpr int kMaxCells = 64;
+
+    // Throws std::invalid_argument when the board has more than 64 cells.
+    PlacementTable(int w, int h, const std::vector<Piece>& pieces);
+
+    static bool supports(int w, int h) { return w > 0 && h > 0 && w * h <= kMaxCells; }
+
+    int get_width() const { return width; }
+    int get_height() const { return height; }
+    int cell_count() const { return width * height; }
+    uint64_t full_mask() const { return full; }
+
+    const PieceInventory& get_inventory() const { return inventory; }
+
+    uint32_t bucket_begin(int cell) const { return begin[cell]; }
+    uint32_t bucket_end(int cell) const { return begin[cell + 1]; }
+    uint32_t largest_bucket() const;
+
+    size_t size() const { return placements.size(); }
+    const TablePlacement& at(uint32_t index) const { return placements[index]; }
+    const std::vector<TablePlacement>& get_placements() const { return placements; }
+
+    Placement to_placement(uint32_t index) const;
+
+    static int first_empty(uint64_t occupied) { return std::countr_one(occupied); }
+
+private:
+    int width, height;
+    uint64_t full;
+    PieceInventory inventory;
+    std::vector<TablePlacement> placements;
+    std::vector<uint32_t> begin;    // cell_count() + 1 bucket boundaries
+};
+
+#endif
@@ -0,0 +1,298 @@
+#include "portfolio_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "iterative_solver.h"
+#include "placement_table.h"
+
+const char* to_string(PortfolioStrategy s) {
+    switch (s) {
+        case PortfolioStrategy::TableOrder:        return "table_order";
+        case PortfolioStrategy::FewestOptionsCell: return "fewest_options_cell";
+        case PortfolioStrategy::RandomRestarts:    return "random_restarts";
+        case PortfolioStrategy::Transposed:        return "transposed";
+        case PortfolioStrategy::ConstrainedPieces: return "constrained_pieces";
+        case PortfolioStrategy::ReversedPieces:    return "reversed_pieces";
+    }
+    return "unknown";
+}
+
+namespace {
+
+enum class Outcome { Found, Exhausted, Budget, Stopped };
+
+// Bitmask search over a PlacementTable with a choice of branching cell and
+// candidate order. Complete unless a budget or the stop flag cuts it short.
+class CoverSearch {
+public:
+    CoverSearch(const PlacementTable& table, bool fewest_options, const std::atomic<bool>& stop,
+                uint64_t check_every)
+        : table(table), fewest_options(fewest_options), stop(stop),
+          check_every(std::max<uint64_t>(1, check_every)), lists(table.cell_count()) {
+        for (int c = 0; c < table.cell_count(); ++c) {
+            if (fewest_options) {
+                // every placement covering c, not only those anchored there
+                for (uint32_t k = 0; k < table.size(); ++k) {
+                    if (table.at(k).mask >> c & 1) lists[c].push_back(k);
+                }
+            } else {
+                for (uint32_t k = table.bucket_begin(c); k < table.bucket_end(c); ++k) lists[c].push_back(k);
+            }
+        }
+    }
+
+    void shuffle(std::mt19937_64& rng) {
+        for (auto& l : lists) std::shuffle(l.begin(), l.end(), rng);
+    }
+
+    // budget > 0 gives up after that many placements
+    Outcome run(uint64_t budget) {
+        piece_left = table.get_inventory().initial_counts();
+        path.clear();
+        run_nodes = 0;
+        run_budget = budget;
+        outcome = Outcome::Exhausted;
+        dfs(0);
+        return outcome;
+    }
+
+    std::vector<Placement> placements() const {
+        std::vector<Placement> out;
+        for (uint32_t k : path) out.push_back(table.to_placement(k));
+        return out;
+    }
+
+    uint64_t nodes = 0;     // over every run
+
+private:
+    // true when the search must unwind (solution, budget or stop)
+    bool dfs(uint64_t occupied) {
+        if (occupied == table.full_mask()) {
+            outcome = Outcome::Found;
+            return true;
+        }
+
+        int cell = PlacementTable::first_empty(occupied);
+        if (fewest_options) {
+            int best = INT_MAX;
+            for (uint64_t empty = ~occupied & table.full_mask(); empty; empty &= empty - 1) {
+                const int c = std::countr_zero(empty);
+                int fitting = 0;
+                for (uint32_t k : lists[c]) {
+                    const TablePlacement& p = table.at(k);
+                    if (piece_left[p.kind_index] > 0 && !(p.mask & occupied) && ++fitting >= best) break;
+                }
+                if (fitting == 0) return false;     // a cell nothing can cover
+                if (fitting < best) {
+                    best = fitting;
+                    cell = c;
+                    if (best == 1) break;
+                }
+            }
+        }
+
+        for (uint32_t k : lists[cell]) {
+            const TablePlacement& p = table.at(k);
+            if (piece_left[p.kind_index] == 0 || (p.mask & occupied)) continue;
+
+            ++nodes;
+            if (run_budget > 0 && ++run_nodes > run_budget) {
+                outcome = Outcome::Budget;
+                return true;
+            }
+            if (nodes % check_every == 0 && stop.load(std::memory_order_relaxed)) {
+                outcome = Outcome::Stopped;
+                return true;
+            }
+
+            --piece_left[p.kind_index];
+            path.push_back(k);
+            if (dfs(occupied | p.mask)) return true;
+            path.pop_back();
+            ++piece_left[p.kind_index];
+        }
+        return false;
+    }
+
+    const PlacementTable& table;
+    bool fewest_options;
+    const std::atomic<bool>& stop;
+    uint64_t check_every;
+    std::vector<std::vector<uint32_t>> lists;   // candidates per branching cell
+
+    std::vector<int> piece_left;
+    std::vector<uint32_t> path;
+    uint64_t run_nodes = 0;
+    uint64_t run_budget = 0;
+    Outcome outcome = Outcome::Exhausted;
+};
+
+// 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ... (i >= 1)
+uint64_t luby(uint64_t i) {
+    for (int k = 1;; ++k) {
+        const uint64_t block = (1ull << k) - 1;
+        if (i == block) return 1ull << (k - 1);
+        if (i < block) return luby(i - (block >> 1));
+    }
+}
+
+// The same placement on the board mirrored across its diagonal.
+Placement transpose(const Piece& piece, const Placement& p) {
+    std::vector<Cell> cells;
+    for (const auto& c : piece.get_variants()[p.get_variant_index()]) cells.push_back(Cell{c.y, c.x});
+    cells = Piece::normalize(cells);
+
+    const auto& variants = piece.get_variants();
+    for (size_t v = 0; v < variants.size(); ++v) {
+        if (Piece::normalize(variants[v]) == cells) {
+            return Placement(p.get_piece_id(), (int)v, Cell{p.get_offset().y, p.get_offset().x});
+        }
+    }
+    // variants are closed under reflection, so this does not happen
+    throw std::logic_error("No transposed variant for piece " + std::to_string(p.get_piece_id()));
+}
+
+class Race {
+public:
+    std::atomic<bool> stop{false};
+
+    void finish(PortfolioStrategy s, bool solved, std::vector<Placement> path, uint64_t nodes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (done) return;
+        done = true;
+        result.solved = solved;
+        result.path = std::move(path);
+        result.winner = s;
+        result.nodes = nodes;
+        stop.store(true, std::memory_order_relaxed);
+    }
+
+    PortfolioResult take() { return std::move(result); }
+
+private:
+    std::mutex mutex;
+    bool done = false;
+    PortfolioResult result;
+};
+
+// Continue `solver` until it answers or another strategy has.
+void run_iterative(Race& race, PortfolioStrategy s, IterativeSolver& solver, uint64_t check_every,
+                   bool transposed, const std::vector<Piece>& level_pieces,
+                   const std::function<bool()>& should_stop = nullptr) {
+    while (!race.stop.load(std::memory_order_relaxed)) {
+        if (should_stop && should_stop()) {
+            race.stop.store(true, std::memory_order_relaxed);
+            return;
+        }
+        const SearchStatus status = solver.next(check_every);
+        if (status == SearchStatus::Paused) continue;
+
+        std::vector<Placement> path;
+        if (status == SearchStatus::Found) {
+            path = solver.get_placements_path();
+            if (transposed) {
+                for (auto& p : path) {
+                    const auto it = std::find_if(level_pieces.begin(), level_pieces.end(),
+                                                 [&](const Piece& q) { return q.get_id() == p.get_piece_id(); });
+                    p = transpose(*it, p);
+                }
+            }
+        }
+        race.finish(s, status == SearchStatus::Found, std::move(path), solver.get_stats().nodes);
+        return;
+    }
+}
+
+void run_iterative(Race& race, PortfolioStrategy s, int w, int h, const std::vector<Piece>& pieces,
+                   uint64_t check_every, bool transposed, const std::vector<Piece>& level_pieces) {
+    IterativeSolver solver(w, h, pieces);
+    run_iterative(race, s, solver, check_every, transposed, level_pieces);
+}
+
+void run_cover(Race& race, PortfolioStrategy s, const PlacementTable& table, const PortfolioOptions& o) {
+    const bool restarts = s == PortfolioStrategy::RandomRestarts;
+    CoverSearch search(table, !restarts, race.stop, o.check_every);
+    std::mt19937_64 rng(o.seed);
+
+    for (uint64_t i = 1;; ++i) {
+        if (restarts) search.shuffle(rng);
+        const Outcome out = search.run(restarts ? 1024 * luby(i) : 0);
+        if (out == Outcome::Stopped) return;
+        if (out == Outcome::Budget) continue;
+        race.finish(s, out == Outcome::Found, out == Outcome::Found ? search.placements() : std::vector<Placement>{},
+                    search.nodes);
+        return;
+    }
+}
+
+}  // namespace
+
+PortfolioResult solve_portfolio(int width, int height, const std::vector<Piece>& pieces,
+                                const PortfolioOptions& options) {
+    const PlacementTable table(width, height, pieces);   // throws for > 64 cells
+    const int n = std::clamp(options.threads, 1, kPortfolioStrategies);
+
+    std::vector<Piece> reversed(pieces.rbegin(), pieces.rend());
+
+    // fewest legal placements first: the hardest pieces to fit decide early
+    std::map<int, size_t> fits;
+    for (const auto& p : table.get_placements()) {
+        ++fits[table.get_inventory().get_kinds()[p.kind_index].piece->get_id()];
+    }
+    std::vector<Piece> constrained = pieces;
+    std::stable_sort(constrained.begin(), constrained.end(),
+                     [&](const Piece& a, const Piece& b) { return fits[a.get_id()] < fits[b.get_id()]; });
+
+    // The /solve order runs on the calling thread. It gets a head start
+    // alone: most levels finish inside it, and only the slow tail pays for
+    // starting the other threads.
+    Race race;
+    IterativeSolver table_order(width, height, pieces);
+    const SearchStatus first = table_order.next(n > 1 ? options.head_start_nodes : 0);
+    if (first != SearchStatus::Paused) {
+        race.finish(PortfolioStrategy::TableOrder, first == SearchStatus::Found,
+                    first == SearchStatus::Found ? table_order.get_placements_path() : std::vector<Placement>{},
+                    table_order.get_stats().nodes);
+        PortfolioResult result = race.take();
+        result.threads = 1;
+        return result;
+    }
+
+    auto run = [&](PortfolioStrategy s) {
+        switch (s) {
+            case PortfolioStrategy::TableOrder:
+                // the calling thread: the only one that polls options.should_stop
+                run_iterative(race, s, table_order, options.check_every, false, pieces, options.should_stop);
+                break;
+            case PortfolioStrategy::FewestOptionsCell:
+            case PortfolioStrategy::RandomRestarts:
+                run_cover(race, s, table, options);
+                break;
+            case PortfolioStrategy::Transposed:
+                run_iterative(race, s, height, width, pieces, options.check_every, true, pieces);
+                break;
+            case PortfolioStrategy::ConstrainedPieces:
+                run_iterative(race, s, width, height, constrained, options.check_every, false, pieces);
+                break;
+            case PortfolioStrategy::ReversedPieces:
+                run_iterative(race, s, width, height, reversed, options.check_every, false, pieces);
+                break;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < n; ++i) threads.emplace_back(run, (PortfolioStrategy)i);
+    run(PortfolioStrategy::TableOrder);
+    for (auto& t : threads) t.join();
+
+    PortfolioResult result = race.take();
+    result.threads = n;
+    return result;
+}
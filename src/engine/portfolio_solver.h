@@ -0,0 +1,70 @@
+#ifndef PORTFOLIO_SOLVER_H
+#define PORTFOLIO_SOLVER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "piece.h"
+#include "placement.h"
+
+// First-solution race between differently ordered searches.
+// --------------------------------
+// Every search order has instances where it is unlucky: the solution sits
+// behind a huge dead subtree that another order never enters. A portfolio
+// runs several orders on their own threads; the first one to answer (a
+// solution, or a complete search proving there is none) wins and the others
+// stop at their next check of a shared flag.
+//
+// TableOrder runs alone for a head start first, so easy levels never pay for
+// the threads. Strategies, in the order threads are handed out:
+//   TableOrder          the /solve order (IterativeSolver, first empty cell)
+//   FewestOptionsCell   branch on the empty cell with the fewest fitting
+//                       placements instead of the first one
+//   RandomRestarts      first empty cell, shuffled candidates, restarted with
+//                       growing node budgets (Luby sequence); complete once a
+//                       budget exceeds the tree
+//   Transposed          the same search on the board turned on its diagonal,
+//                       i.e. column-major cell order
+//   ConstrainedPieces   pieces with the fewest legal placements tried first
+//   ReversedPieces      level piece order reversed
+//
+// Boards of at most 64 cells (see PlacementTable::supports).
+enum class PortfolioStrategy {
+    TableOrder,
+    FewestOptionsCell,
+    RandomRestarts,
+    Transposed,
+    ConstrainedPieces,
+    ReversedPieces,
+};
+
+constexpr int kPortfolioStrategies = 6;
+
+const char* to_string(PortfolioStrategy s);
+
+class PortfolioOptions {
+public:
+    int threads = 4;                // strategies run; 1 = TableOrder only
+    uint64_t seed = 1;              // RandomRestarts shuffles
+    uint64_t check_every = 4096;    // nodes between looks at the stop flag
+    uint64_t head_start_nodes = 20000;  // TableOrder alone first; most levels end here
+    // Polled by the calling thread every check_every nodes after the head
+    // start; true stops the race with no answer (solved false).
+    std::function<bool()> should_stop;
+};
+
+class PortfolioResult {
+public:
+    bool solved = false;
+    std::vector<Placement> path;            // level piece ids, board coordinates
+    PortfolioStrategy winner = PortfolioStrategy::TableOrder;
+    uint64_t nodes = 0;                     // placements made by the winner
+    int threads = 0;                        // strategies started (1 when the head start answered)
+};
+
+// Throws std::invalid_argument when the board has more than 64 cells.
+PortfolioResult solve_portfolio(int width, int height, const std::vector<Piece>& pieces,
+                                const PortfolioOptions& options = PortfolioOptions{});
+
+#endif
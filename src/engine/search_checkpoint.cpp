@@ -0,0 +1,113 @@
+#include "search_checkpoint.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint16_t kFlagAtSolution = 1u << 0;
+constexpr uint16_t kFlagExhausted = 1u << 1;
+
+class Writer {
+public:
+    std::vector<uint8_t> out;
+
+    void u8(uint8_t v) { out.push_back(v); }
+    void u16(uint16_t v) {
+        u8((uint8_t)v);
+        u8((uint8_t)(v >> 8));
+    }
+    void u64(uint64_t v) {
+        for (int i = 0; i < 8; ++i) u8((uint8_t)(v >> (8 * i)));
+    }
+};
+
+class Reader {
+public:
+    explicit Reader(const std::vector<uint8_t>& b) : bytes(b) {}
+
+    uint8_t u8() {
+        if (pos >= bytes.size()) throw std::runtime_error("Truncated search checkpoint");
+        return bytes[pos++];
+    }
+    uint16_t u16() {
+        uint16_t lo = u8();
+        return (uint16_t)(lo | (u8() << 8));
+    }
+    uint64_t u64() {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= (uint64_t)u8() << (8 * i);
+        return v;
+    }
+    bool done() const { return pos == bytes.size(); }
+
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t pos = 0;
+};
+
+}  // namespace
+
+std::vector<uint8_t> SearchCheckpoint::serialize() const {
+    Writer w;
+    for (char c : {'P', 'Z', 'C', 'K'}) w.u8((uint8_t)c);
+    w.u16(kVersion);
+    w.u16((at_solution ? kFlagAtSolution : 0) | (exhausted ? kFlagExhausted : 0));
+    w.u16((uint16_t)width);
+    w.u16((uint16_t)height);
+    w.u16((uint16_t)piece_ids.size());
+    w.u16((uint16_t)decisions.size());
+    w.u64(nodes);
+    w.u64(solutions);
+    for (int id : piece_ids) w.u8((uint8_t)id);
+    for (uint16_t d : decisions) w.u16(d);
+    w.u16(next);
+    w.u16((uint16_t)piece_left.size());
+    for (uint8_t n : piece_left) w.u8(n);
+    return w.out;
+}
+
+SearchCheckpoint SearchCheckpoint::deserialize(const std::vector<uint8_t>& bytes) {
+    Reader r(bytes);
+    for (char c : {'P', 'Z', 'C', 'K'}) {
+        if (r.u8() != (uint8_t)c) throw std::runtime_error("Not a search checkpoint");
+    }
+    if (r.u16() != kVersion) throw std::runtime_error("Unsupported search checkpoint version");
+
+    SearchCheckpoint cp;
+    const uint16_t flags = r.u16();
+    cp.at_solution = flags & kFlagAtSolution;
+    cp.exhausted = flags & kFlagExhausted;
+    cp.width = r.u16();
+    cp.height = r.u16();
+    const uint16_t piece_count = r.u16();
+    const uint16_t depth = r.u16();
+    cp.nodes = r.u64();
+    cp.solutions = r.u64();
+
+    cp.piece_ids.resize(piece_count);
+    for (auto& id : cp.piece_ids) id = r.u8();
+    cp.decisions.resize(depth);
+    for (auto& d : cp.decisions) d = r.u16();
+    cp.next = r.u16();
+    cp.piece_left.resize(r.u16());
+    for (auto& n : cp.piece_left) n = r.u8();
+
+    if (!r.done()) throw std::runtime_error("Trailing bytes in search checkpoint");
+    return cp;
+}
+
+void SearchCheckpoint::save(const std::string& filename) const {
+    const auto bytes = serialize();
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize)bytes.size());
+    if (!out) throw std::runtime_error("Could not write search checkpoint: " + filename);
+}
+
+SearchCheckpoint SearchCheckpoint::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) throw std::runtime_error("Could not open search checkpoint: " + filename);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return deserialize(bytes);
+}
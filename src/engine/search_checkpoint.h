@@ -0,0 +1,47 @@
+#ifndef SEARCH_CHECKPOINT_H
+#define SEARCH_CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Complete state of an IterativeSolver, small enough to store or send.
+// --------------------------------
+// The board and the used pieces follow from the decisions, so they are
+// replayed on resume; piece_left is kept only to validate that replay.
+//
+// Binary layout (little endian):
+//   "PZCK" u16 version u16 flags
+//   u16 width u16 height u16 piece_count u16 depth
+//   u64 nodes u64 solutions
+//   u8  piece_ids[piece_count]
+//   u16 decisions[depth]   u16 next
+//   u8  piece_left[kind count]  (prefixed by u16 kind count)
+class SearchCheckpoint {
+public:
+    static constexpr uint16_t kVersion = 1;
+
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;         // the instance, in solver order
+
+    std::vector<uint16_t> decisions;    // bucket-relative index per depth
+    uint16_t next = 0;                  // next candidate of the top frame
+    bool at_solution = false;           // decisions form a full solution
+    bool exhausted = false;             // nothing left to search
+
+    std::vector<uint8_t> piece_left;    // copies left per kind
+
+    uint64_t nodes = 0;
+    uint64_t solutions = 0;
+
+    std::vector<uint8_t> serialize() const;
+
+    // Throws std::runtime_error on malformed input.
+    static SearchCheckpoint deserialize(const std::vector<uint8_t>& bytes);
+
+    void save(const std::string& filename) const;
+    static SearchCheckpoint load(const std::string& filename);
+};
+
+#endif
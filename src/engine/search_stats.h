@@ -0,0 +1,14 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <cstdint>
+
+// Counters kept by the bitmask engines.
+class SearchStats {
+public:
+    uint64_t nodes = 0;             // placements made
+    uint64_t placement_tests = 0;   // candidates checked against the board
+    uint64_t solutions = 0;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "search_trace.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+TraceRecorder::TraceRecorder(size_t capacity, uint32_t sample, uint64_t max)
+    : ring(round_up_pow2(capacity < 2 ? 2 : capacity)),
+      mask(ring.size() - 1),
+      sample_every(sample == 0 ? 1 : sample),
+      max_events(max) {}
+
+size_t TraceRecorder::drain(std::vector<TraceEvent>& out) {
+    uint64_t tail = read_index.load(std::memory_order_relaxed);
+    const uint64_t head = write_index.load(std::memory_order_acquire);
+    const size_t n = (size_t)(head - tail);
+
+    out.reserve(out.size() + n);
+    for (; tail != head; ++tail) {
+        out.push_back(ring[tail & mask]);
+    }
+    read_index.store(tail, std::memory_order_release);
+    return n;
+}
+
+namespace {
+
+struct TraceFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t reserved;
+    uint32_t count;
+};
+
+constexpr char kTraceMagic[4] = {'P', 'Z', 'T', 'R'};
+constexpr uint16_t kTraceVersion = 1;
+
+}  // namespace
+
+std::string encode_trace(int width, int height, const std::vector<TraceEvent>& events) {
+    TraceFileHeader h{};
+    std::memcpy(h.magic, kTraceMagic, sizeof(kTraceMagic));
+    h.version = kTraceVersion;
+    h.width = (uint16_t)width;
+    h.height = (uint16_t)height;
+    h.count = (uint32_t)events.size();
+
+    std::string out(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.append(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(TraceEvent));
+    return out;
+}
+
+void write_trace_file(const std::string& filename, int width, int height,
+                      const std::vector<TraceEvent>& events) {
+    const std::string bytes = encode_trace(width, height, events);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), (std::streamsize)bytes.size());
+    if (!out) throw std::runtime_error("Could not write trace file: " + filename);
+}
+
+std::vector<TraceEvent> read_trace_file(const std::string& filename, int& width, int& height) {
+    std::ifstream in(filename, std::ios::binary);
+    TraceFileHeader h{};
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) ||
+        std::memcmp(h.magic, kTraceMagic, sizeof(kTraceMagic)) != 0 || h.version != kTraceVersion) {
+        throw std::runtime_error("Not a trace file: " + filename);
+    }
+
+    std::vector<TraceEvent> events(h.count);
+    if (!in.read(reinterpret_cast<char*>(events.data()), (std::streamsize)(events.size() * sizeof(TraceEvent)))) {
+        throw std::runtime_error("Truncated trace file: " + filename);
+    }
+    width = h.width;
+    height = h.height;
+    return events;
+}
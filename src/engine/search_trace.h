@@ -0,0 +1,120 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cell.h"
+
+// Place / remove events of a search, for step-by-step replay (T9.1).
+// --------------------------------
+// The solver thread is the only producer and writes fixed 8-byte events into
+// a single-producer / single-consumer ring; a reader drains it concurrently
+// or after the solve. Nothing allocates or locks on the record path.
+//
+// sample_every = N keeps one placement in N together with its removal, so a
+// sampled stream still replays: every Remove undoes a kept Place, and the
+// board shown is always a subset of the real one. The pairing is tracked per
+// search depth (placements deeper than kMaxSampledDepth are always kept).
+// max_events stops recording once that many events were kept (0 = no cap),
+// leaving a replayable prefix. When the ring is full the event is counted in
+// dropped() instead of blocking the search; such a stream does not replay.
+enum class TraceEventKind : uint8_t {
+    Place = 1,
+    Remove = 2,
+    Solved = 3,
+};
+
+struct TraceEvent {
+    uint8_t kind;           // TraceEventKind
+    uint8_t piece_id;
+    uint8_t variant_index;
+    uint8_t reserved;
+    int16_t x;              // offset of the variant
+    int16_t y;
+};
+
+static_assert(sizeof(TraceEvent) == 8);
+
+class TraceRecorder {
+public:
+    static constexpr size_t kMaxSampledDepth = 1024;
+
+    explicit TraceRecorder(size_t capacity = 1u << 16, uint32_t sample_every = 1, uint64_t max_events = 0);
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // producer side (solver thread)
+    void record(TraceEventKind kind, int piece_id, int variant_index, const Cell& offset) {
+        ++seen_count;
+        bool keep = true;
+        if (kind == TraceEventKind::Place) {
+            keep = ++place_count % sample_every == 0;
+            if (depth < kMaxSampledDepth) kept_at_depth[depth] = keep;
+            else keep = true;
+            ++depth;
+        } else if (kind == TraceEventKind::Remove && depth > 0) {
+            --depth;
+            keep = depth >= kMaxSampledDepth || kept_at_depth[depth];
+        }
+        if (!keep) return;
+        if (max_events > 0 && kept_count >= max_events) {
+            truncated_flag = true;
+            return;
+        }
+        push(TraceEvent{(uint8_t)kind, (uint8_t)piece_id, (uint8_t)variant_index, 0,
+                        (int16_t)offset.x, (int16_t)offset.y});
+    }
+
+    // consumer side; appends what is available, returns how many
+    size_t drain(std::vector<TraceEvent>& out);
+
+    uint64_t seen() const { return seen_count; }
+    uint64_t kept() const { return kept_count; }
+    uint64_t dropped() const { return dropped_count; }
+    bool truncated() const { return truncated_flag; }
+
+private:
+    void push(const TraceEvent& ev) {
+        const uint64_t head = write_index.load(std::memory_order_relaxed);
+        if (head - read_index.load(std::memory_order_acquire) == ring.size()) {
+            ++dropped_count;
+            return;
+        }
+        ring[head & mask] = ev;
+        write_index.store(head + 1, std::memory_order_release);
+        ++kept_count;
+    }
+
+    std::vector<TraceEvent> ring;   // power-of-two size
+    uint64_t mask;
+
+    alignas(64) std::atomic<uint64_t> write_index{0};
+    alignas(64) std::atomic<uint64_t> read_index{0};
+
+    // producer-only counters
+    alignas(64) uint64_t seen_count = 0;
+    uint64_t kept_count = 0;
+    uint64_t dropped_count = 0;
+    bool truncated_flag = false;
+    uint64_t place_count = 0;
+    size_t depth = 0;                               // pieces on the board
+    std::bitset<kMaxSampledDepth> kept_at_depth;    // Place kept, so keep its Remove
+    uint32_t sample_every;
+    uint64_t max_events;
+};
+
+// Binary trace file: "PZTR" u16 version u16 width u16 height u16 reserved
+// u32 event count, then TraceEvent records. Throws std::runtime_error.
+std::string encode_trace(int width, int height, const std::vector<TraceEvent>& events);
+
+void write_trace_file(const std::string& filename, int width, int height,
+                      const std::vector<TraceEvent>& events);
+
+std::vector<TraceEvent> read_trace_file(const std::string& filename, int& width, int& height);
+
+#endif
@@ -0,0 +1,39 @@
+#include "solution_count.h"
+
+#include <stdexcept>
+
+#include "board.h"
+#include "frontier_counter.h"
+#include "iterative_solver.h"
+#include "kernel_dispatch.h"
+#include "placement_table.h"
+#include "solver.h"
+
+SolutionCount count_level_solutions(int width, int height, const std::vector<Piece>& pieces, uint64_t limit) {
+    SolutionCount out;
+    if (FrontierCounter::supports(width, height, pieces)) {
+        try {
+            out.count = FrontierCounter(width, height, pieces).count();
+            out.engine = "frontier";
+            return out;
+        } catch (const std::length_error&) {
+            // too many profiles for the state table: search instead
+        }
+    }
+
+    if (const SolverKernel* kernel = find_kernel(width, height)) {
+        out.count = kernel->count(pieces, limit);
+        out.engine = "kernel";
+    } else if (PlacementTable::supports(width, height)) {
+        IterativeSolver solver(width, height, pieces);
+        out.count = solver.count_solutions(limit);
+        out.engine = "iterative";
+    } else {
+        Board board(width, height);
+        Solver solver(board, pieces);
+        out.count = solver.count_solutions(limit);
+        out.engine = "generic";
+    }
+    out.complete = limit == 0 || out.count < limit;
+    return out;
+}
@@ -0,0 +1,26 @@
+#ifndef SOLUTION_COUNT_H
+#define SOLUTION_COUNT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "piece.h"
+
+class SolutionCount {
+public:
+    uint64_t count = 0;
+    bool complete = true;           // false: a search stopped at the limit
+    const char* engine = "";        // frontier, kernel, iterative or generic
+};
+
+// Counting dispatch for the level tools.
+// --------------------------------
+// FrontierCounter where it supports the board and pieces; it counts every
+// solution whatever the limit, so its count can exceed `limit` and is always
+// complete. When its state table fills up, or it does not apply, a search
+// counts instead and stops at limit (> 0): the FixedSolver kernel of the
+// board shape, else IterativeSolver (<= 64 cells), else the generic Solver.
+// Every engine counts the same solutions as Solver::count_solutions.
+SolutionCount count_level_solutions(int width, int height, const std::vector<Piece>& pieces, uint64_t limit = 0);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef SOLUTION_SINK_H
+#define SOLUTION_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Receiver of an enumeration's solutions, one at a time.
+// --------------------------------
+// A solution arrives as its decisions (see PlacementTable): decisions[d] is
+// the chosen placement's offset in the anchor bucket at depth d. The array
+// is only valid during the call; a sink that keeps solutions copies them.
+class SolutionSink {
+public:
+    virtual ~SolutionSink() = default;
+
+    virtual void on_solution(const uint16_t* decisions, size_t count) = 0;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "solution_stream.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "piece_library.h"
+
+using namespace solutionstream;
+
+SolutionFileWriter::SolutionFileWriter(const std::string& path, const PlacementTable& table,
+                                       const std::vector<int>& piece_ids, size_t buffer_bytes) {
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.width = (uint16_t)table.get_width();
+    header.height = (uint16_t)table.get_height();
+    header.piece_count = (uint16_t)piece_ids.size();
+    header.decision_bytes = table.largest_bucket() <= 256 ? 1 : 2;
+    record_bytes = piece_ids.size() * header.decision_bytes;
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("Could not create solution stream: " + path);
+
+    std::vector<uint16_t> ids(piece_ids.begin(), piece_ids.end());
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+        std::fwrite(ids.data(), sizeof(uint16_t), ids.size(), file) != ids.size()) {
+        std::fclose(file);
+        throw std::runtime_error("Could not write solution stream: " + path);
+    }
+
+    // at least one record per buffer
+    const size_t size = std::max(buffer_bytes, record_bytes);
+    buffers[0].resize(size);
+    buffers[1].resize(size);
+    writer = std::thread(&SolutionFileWriter::writer_loop, this);
+}
+
+SolutionFileWriter::~SolutionFileWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // nothing to report to from a destructor; call close() to see errors
+    }
+}
+
+void SolutionFileWriter::on_solution(const uint16_t* decisions, size_t count) {
+    if (fill + record_bytes > buffers[active].size()) hand_off();
+
+    uint8_t* out = buffers[active].data() + fill;
+    for (size_t d = 0; d < count && d < header.piece_count; ++d) {
+        if (header.decision_bytes == 1) {
+            out[d] = (uint8_t)decisions[d];
+        } else {
+            out[2 * d] = (uint8_t)(decisions[d] & 0xff);
+            out[2 * d + 1] = (uint8_t)(decisions[d] >> 8);
+        }
+    }
+    fill += record_bytes;
+    ++solutions;
+}
+
+// Give the active buffer to the writer and continue in the other one, once
+// the writer has finished with it.
+void SolutionFileWriter::hand_off() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return pending == 0; });
+    pending = fill;
+    active ^= 1;
+    fill = 0;
+    cv.notify_all();
+}
+
+void SolutionFileWriter::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [&] { return pending > 0 || stopping; });
+        if (pending == 0) return;
+
+        const std::vector<uint8_t>& buf = buffers[active ^ 1];
+        const size_t bytes = pending;
+        lock.unlock();
+        const bool ok = std::fwrite(buf.data(), 1, bytes, file) == bytes;
+        lock.lock();
+
+        if (!ok) failed = true;
+        pending = 0;
+        cv.notify_all();
+    }
+}
+
+void SolutionFileWriter::close() {
+    if (closed) return;
+    closed = true;
+
+    if (fill > 0) hand_off();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    writer.join();
+
+    header.solution_count = solutions;
+    bool ok = !failed && std::fseek(file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok) throw std::runtime_error("Could not write solution stream");
+}
+
+SolutionFileReader::SolutionFileReader(const std::string& path) : in(path, std::ios::binary) {
+    if (!in) throw std::runtime_error("Could not open solution stream: " + path);
+
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        (header.decision_bytes != 1 && header.decision_bytes != 2) || header.piece_count == 0) {
+        throw std::runtime_error("Not a solution stream: " + path);
+    }
+
+    std::vector<uint16_t> ids(header.piece_count);
+    in.read(reinterpret_cast<char*>(ids.data()), (std::streamsize)(ids.size() * sizeof(uint16_t)));
+    if (!in) throw std::runtime_error("Truncated solution stream: " + path);
+    piece_ids.assign(ids.begin(), ids.end());
+
+    pieces = PieceLibrary::get_piece_by_id(piece_ids);
+    table = std::make_unique<PlacementTable>(header.width, header.height, pieces);
+    records_offset = sizeof(header) + ids.size() * sizeof(uint16_t);
+    record_bytes = (size_t)header.piece_count * header.decision_bytes;
+
+    in.seekg(0, std::ios::end);
+    const uint64_t file_size = (uint64_t)in.tellg();
+    // division, not records_offset + count * record_bytes: a corrupt count wraps that
+    if (file_size < records_offset || header.solution_count > (file_size - records_offset) / record_bytes) {
+        throw std::runtime_error("Truncated solution stream: " + path);
+    }
+}
+
+std::vector<uint16_t> SolutionFileReader::decisions(uint64_t index) {
+    if (index >= size()) throw std::out_of_range("Solution index out of range");
+
+    std::vector<uint8_t> raw(record_bytes);
+    in.seekg((std::streamoff)(records_offset + index * record_bytes));
+    in.read(reinterpret_cast<char*>(raw.data()), (std::streamsize)raw.size());
+    if (!in) throw std::runtime_error("Could not read solution stream record");
+
+    std::vector<uint16_t> out(header.piece_count);
+    for (size_t d = 0; d < out.size(); ++d) {
+        out[d] = header.decision_bytes == 1 ? raw[d] : (uint16_t)(raw[2 * d] | (raw[2 * d + 1] << 8));
+    }
+    return out;
+}
+
+std::vector<Placement> SolutionFileReader::placements(uint64_t index) {
+    std::vector<Placement> out;
+    uint64_t occupied = 0;
+    for (uint16_t d : decisions(index)) {
+        // a full board has no first empty cell: more decisions overrun it
+        const int cell = PlacementTable::first_empty(occupied);
+        if (cell >= table->cell_count()) {
+            throw std::runtime_error("Corrupt solution stream record");
+        }
+        const uint32_t k = table->bucket_begin(cell) + d;
+        if (k >= table->bucket_end(cell) || (table->at(k).mask & occupied)) {
+            throw std::runtime_error("Corrupt solution stream record");
+        }
+        out.push_back(table->to_placement(k));
+        occupied |= table->at(k).mask;
+    }
+    if (occupied != table->full_mask()) {
+        throw std::runtime_error("Corrupt solution stream record");
+    }
+    return out;
+}
@@ -0,0 +1,124 @@
+#ifndef SOLUTION_STREAM_H
+#define SOLUTION_STREAM_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "piece.h"
+#include "placement.h"
+#include "placement_table.h"
+#include "solution_sink.h"
+
+// Solution stream file: every solution of one instance, written while the
+// search runs.
+// --------------------------------
+// Records are the decisions of a solution, one byte each when the table's
+// largest bucket fits in a byte (two otherwise), so an all-12-pentomino
+// tiling takes 12 bytes instead of a vector of Placements and its JSON.
+// Reading a record back replays the decisions on the PlacementTable rebuilt
+// from the header's board and piece ids.
+//
+// File layout (little endian):
+//   StreamHeader
+//   uint16 piece_ids[piece_count]     the order the table was built from
+//   records[solution_count]           piece_count * decision_bytes each
+namespace solutionstream {
+
+constexpr char kMagic[8] = {'P', 'Z', 'S', 'T', 'R', 'E', 'A', 'M'};
+constexpr uint32_t kVersion = 1;
+
+struct StreamHeader {
+    char magic[8];
+    uint32_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t piece_count;
+    uint16_t decision_bytes;        // 1 or 2
+    uint32_t reserved;
+    uint64_t solution_count;        // written on close()
+};
+
+static_assert(sizeof(StreamHeader) == 32);
+
+}  // namespace solutionstream
+
+// SolutionSink that appends records to a solution stream file.
+// --------------------------------
+// The search thread only copies records into the active buffer. A full
+// buffer is handed to a writer thread and the search continues in the other
+// one; it waits only when both are full, i.e. when the disk is slower than
+// the search.
+class SolutionFileWriter : public SolutionSink {
+public:
+    // Throws std::runtime_error when the file cannot be created.
+    SolutionFileWriter(const std::string& path, const PlacementTable& table,
+                       const std::vector<int>& piece_ids, size_t buffer_bytes = 1u << 20);
+    ~SolutionFileWriter() override;
+
+    SolutionFileWriter(const SolutionFileWriter&) = delete;
+    SolutionFileWriter& operator=(const SolutionFileWriter&) = delete;
+
+    void on_solution(const uint16_t* decisions, size_t count) override;
+
+    // Flushes, stops the writer thread and fills in the solution count.
+    // Throws std::runtime_error if any write failed.
+    void close();
+
+    uint64_t solution_count() const { return solutions; }
+
+private:
+    void writer_loop();
+    void hand_off();
+
+    std::FILE* file = nullptr;
+    solutionstream::StreamHeader header{};
+    size_t record_bytes = 0;
+    uint64_t solutions = 0;
+
+    std::vector<uint8_t> buffers[2];
+    size_t fill = 0;                // bytes in buffers[active]
+    int active = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t pending = 0;             // bytes of buffers[active ^ 1] the writer owes; 0 = free
+    bool stopping = false;
+    bool failed = false;
+    bool closed = false;
+    std::thread writer;
+};
+
+// Random access to the records of a solution stream file (not thread-safe).
+class SolutionFileReader {
+public:
+    // Throws std::runtime_error on a missing, truncated or foreign file.
+    explicit SolutionFileReader(const std::string& path);
+
+    int get_width() const { return header.width; }
+    int get_height() const { return header.height; }
+    const std::vector<int>& get_piece_ids() const { return piece_ids; }
+    const std::vector<Piece>& get_pieces() const { return pieces; }
+    uint64_t size() const { return header.solution_count; }
+
+    // Solution `index` (< size()) in level piece ids and board coordinates.
+    std::vector<Placement> placements(uint64_t index);
+    std::vector<uint16_t> decisions(uint64_t index);
+
+private:
+    solutionstream::StreamHeader header{};
+    std::vector<int> piece_ids;
+    std::vector<Piece> pieces;
+    std::unique_ptr<PlacementTable> table;
+    std::ifstream in;
+    uint64_t records_offset = 0;
+    size_t record_bytes = 0;
+};
+
+#endif
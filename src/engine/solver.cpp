@@ -2,45 +2,58 @@
 #include <algorithm>  // std::fill
 
 Solver::Solver(Board& b, const std::vector<Piece>& p)
-    : board(b), pieces(p), piece_used(p.size(), 0) {}
+    : board(b), inventory(p), piece_left(inventory.initial_counts()) {}
 
 
 void Solver::reset() {
     placements_path.clear();
-    std::fill(piece_used.begin(), piece_used.end(), 0);
+    piece_left = inventory.initial_counts();
 }
 
 
 bool Solver::solve() {
     placements_path.clear();
-    std::fill(piece_used.begin(), piece_used.end(), 0);
+    piece_left = inventory.initial_counts();
 
     return dfs();
 }
 
-bool Solver::dfs() {
-    Cell empty_cell{-1, -1};
+uint64_t Solver::count_solutions(uint64_t limit) {
+    placements_path.clear();
+    piece_left = inventory.initial_counts();
+
+    uint64_t count = 0;
+    count_dfs(count, limit);
+    return count;
+}
+
+Cell Solver::find_empty_cell() const {
     for (int y = 0; y < board.get_height(); ++y) {
         for (int x = 0; x < board.get_width(); ++x) {
             Cell p{x, y};
             if (board.is_empty(p)) {
-                empty_cell = p;
-                break;
+                return p;
             }
         }
-        if (empty_cell.x != -1) break;
     }
+    return Cell{-1, -1};
+}
+
+bool Solver::dfs() {
+    Cell empty_cell = find_empty_cell();
 
     // if no empty cell, solved
     if (empty_cell.x == -1) {
+        if (trace) trace->record(TraceEventKind::Solved, 0, 0, Cell{0, 0});
         return true;
     }
 
-    // 2) 嘗試用每一個還沒使用的 piece 去覆蓋 empty_cell
-    for (size_t i = 0; i < pieces.size(); ++i) {
-        if (piece_used[i]) continue;
+    // 2) 嘗試用每一種還有剩的 piece 去覆蓋 empty_cell
+    const auto& kinds = inventory.get_kinds();
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        if (piece_left[i] == 0) continue;
 
-        const Piece& piece = pieces[i];
+        const Piece& piece = *kinds[i].piece;
         const auto& variants = piece.get_variants();
 
         // 3) 對每一個 variant
@@ -57,8 +70,9 @@ bool Solver::dfs() {
 
                 // 放上去
                 board.place(piece.get_id(), variant, offset);
-                piece_used[i] = 1;
+                --piece_left[i];
                 placements_path.emplace_back(piece.get_id(), (int)v, offset);
+                if (trace) trace->record(TraceEventKind::Place, piece.get_id(), (int)v, offset);
 
                 // 遞迴
                 if (dfs()) {
@@ -67,8 +81,9 @@ bool Solver::dfs() {
 
                 // 回溯
                 placements_path.pop_back();
-                piece_used[i] = 0;
+                ++piece_left[i];
                 board.remove(piece.get_id(), variant, offset);
+                if (trace) trace->record(TraceEventKind::Remove, piece.get_id(), (int)v, offset);
             }
         }
     }
@@ -77,6 +92,43 @@ bool Solver::dfs() {
     return false;
 }
 
+void Solver::count_dfs(uint64_t& count, uint64_t limit) {
+    Cell empty_cell = find_empty_cell();
+    if (empty_cell.x == -1) {
+        ++count;
+        return;
+    }
+
+    const auto& kinds = inventory.get_kinds();
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        if (piece_left[i] == 0) continue;
+
+        const Piece& piece = *kinds[i].piece;
+        const auto& variants = piece.get_variants();
+
+        for (size_t v = 0; v < variants.size(); ++v) {
+            const auto& variant = variants[v];
+
+            for (const auto& vc : variant) {
+                Cell offset{empty_cell.x - vc.x, empty_cell.y - vc.y};
+
+                if (!board.can_place(variant, offset))
+                    continue;
+
+                board.place(piece.get_id(), variant, offset);
+                --piece_left[i];
+
+                count_dfs(count, limit);
+
+                ++piece_left[i];
+                board.remove(piece.get_id(), variant, offset);
+
+                if (limit > 0 && count >= limit) return;
+            }
+        }
+    }
+}
+
 const std::vector<Placement>& Solver::get_placements_path() const {
     return placements_path;
 }
@@ -1,23 +1,30 @@
 #ifndef SOLVER_H
 #define SOLVER_H
 
+#include <cstdint>
 #include "board.h"
+#include "piece_inventory.h"
 #include "placement.h"
+#include "search_trace.h"
 
 class Solver {
     // Solver Steps :
     // 1. Find empty cell
-    // 2. Try to place each piece variant at that cell
+    // 2. Try to place each piece kind's variants at that cell
+    //    (repeated piece ids are one kind with a count, see PieceInventory)
     // 3. If placed, recurse to step 1
     // 4. If no pieces can be placed, backtrack
 
 private:
     bool dfs();
+    void count_dfs(uint64_t& count, uint64_t limit);
+    Cell find_empty_cell() const;
 
     Board& board;
-    const std::vector<Piece>& pieces;
-    std::vector<int> piece_used;    // 0 -> not used, 1 -> used
+    PieceInventory inventory;
+    std::vector<int> piece_left;    // copies of each kind not placed yet
     std::vector<Placement> placements_path; // current placements
+    TraceRecorder* trace = nullptr;         // optional, see set_trace()
 
 public:
     // Solver() = delete;
@@ -26,6 +33,14 @@ public:
     void reset();
     bool solve();
 
+    // Record place/remove events of solve() for replay; nullptr turns it off.
+    void set_trace(TraceRecorder* recorder) { trace = recorder; }
+
+    // Count all solutions (T5.5); limit > 0 stops once that many are found.
+    // Copies of a repeated piece are interchangeable, so swapping them does
+    // not make a new solution.
+    uint64_t count_solutions(uint64_t limit = 0);
+
     const std::vector<Placement>& get_placements_path() const;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "solver_strategy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+
+#include "board.h"
+#include "candidate_filter.h"
+#include "iterative_solver.h"
+#include "kernel_dispatch.h"
+#include "placement_table.h"
+#include "solver.h"
+
+InstanceFeatures describe_instance(int width, int height, const std::vector<Piece>& pieces) {
+    InstanceFeatures f;
+    f.width = width;
+    f.height = height;
+    f.piece_count = (int)pieces.size();
+
+    std::set<int> seen;
+    for (const auto& piece : pieces) {
+        if (!seen.insert(piece.get_id()).second) continue;
+        for (const auto& variant : piece.get_variants()) {
+            int w = 0, h = 0;
+            for (const auto& c : variant) {
+                w = std::max(w, c.x + 1);
+                h = std::max(h, c.y + 1);
+            }
+            f.placements += (long long)std::max(0, width - w + 1) * std::max(0, height - h + 1);
+        }
+    }
+    return f;
+}
+
+// log10(nodes to first solution) ~ a + b * pieces over the catalogue
+static constexpr double kNodesLogA = -1.272;
+static constexpr double kNodesLogB = 0.594;
+
+double CostModel::expected_nodes(const InstanceFeatures& f) {
+    return std::pow(10.0, kNodesLogA + kNodesLogB * f.piece_count);
+}
+
+double CostModel::operator()(const InstanceFeatures& f) const {
+    return setup_us + per_placement_us * (double)f.placements + per_node_us * expected_nodes(f);
+}
+
+namespace {
+
+// Fitted by `benchmark --section strategies` (see solver_strategy.h).
+constexpr CostModel kKernelCost{1.822, 0.01557, 0.07151};
+constexpr CostModel kFilterCost{3.173, 0.02996, 0.03853};
+constexpr CostModel kIterativeCost{2.184, 0.02293, 0.07084};
+constexpr CostModel kGenericCost{0.0, 0.0, 0.34551};
+
+class KernelStrategy : public SolverStrategy {
+public:
+    const char* name() const override { return "kernel"; }
+    bool supports(int w, int h) const override { return find_kernel(w, h) != nullptr; }
+    double estimate_us(const InstanceFeatures& f) const override { return kKernelCost(f); }
+    bool solve(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path) const override {
+        return find_kernel(w, h)->solve(pieces, path);
+    }
+};
+
+class FilterStrategy : public SolverStrategy {
+public:
+    const char* name() const override { return "filter"; }
+    bool supports(int w, int h) const override { return PlacementTable::supports(w, h); }
+    double estimate_us(const InstanceFeatures& f) const override { return kFilterCost(f); }
+    bool solve(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path) const override {
+        SearchStats stats;
+        return solve_with_stats(w, h, pieces, path, stats);
+    }
+    bool solve_with_stats(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path,
+                          SearchStats& stats) const override {
+        PlacementTable table(w, h, pieces);     // <= 64 cells, so <= 64 kinds
+        FilteredSearch search(table);
+        const bool solved = search.solve();
+        stats = search.get_stats();
+        if (!solved) return false;
+        path = search.get_placements_path();
+        return true;
+    }
+};
+
+class IterativeStrategy : public SolverStrategy {
+public:
+    const char* name() const override { return "iterative"; }
+    bool supports(int w, int h) const override { return PlacementTable::supports(w, h); }
+    double estimate_us(const InstanceFeatures& f) const override { return kIterativeCost(f); }
+    bool solve(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path) const override {
+        SearchStats stats;
+        return solve_with_stats(w, h, pieces, path, stats);
+    }
+    bool solve_with_stats(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path,
+                          SearchStats& stats) const override {
+        IterativeSolver solver(w, h, pieces);
+        const bool solved = solver.solve();
+        stats = solver.get_stats();
+        if (!solved) return false;
+        path = solver.get_placements_path();
+        return true;
+    }
+    bool solve_until(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path,
+                     const std::function<bool()>& should_stop) const override {
+        IterativeSolver solver(w, h, pieces);
+        SearchStatus status = SearchStatus::Paused;
+        while (status == SearchStatus::Paused) {
+            if (should_stop && should_stop()) return false;
+            status = solver.next(kStopCheckNodes);
+        }
+        if (status != SearchStatus::Found) return false;
+        path = solver.get_placements_path();
+        return true;
+    }
+
+private:
+    static constexpr uint64_t kStopCheckNodes = 1u << 16;   // ~ a few ms of search
+};
+
+class GenericStrategy : public SolverStrategy {
+public:
+    const char* name() const override { return "generic"; }
+    bool supports(int w, int h) const override { return w > 0 && h > 0; }
+    double estimate_us(const InstanceFeatures& f) const override { return kGenericCost(f); }
+    bool solve(int w, int h, const std::vector<Piece>& pieces, std::vector<Placement>& path) const override {
+        Board board(w, h);
+        Solver solver(board, pieces);
+        if (!solver.solve()) return false;
+        path = solver.get_placements_path();
+        return true;
+    }
+};
+
+}  // namespace
+
+SolverRegistry::SolverRegistry() {
+    add(std::make_unique<KernelStrategy>());
+    add(std::make_unique<FilterStrategy>());
+    add(std::make_unique<IterativeStrategy>());
+    add(std::make_unique<GenericStrategy>());
+}
+
+SolverRegistry& SolverRegistry::instance() {
+    static SolverRegistry registry;
+    return registry;
+}
+
+void SolverRegistry::add(std::unique_ptr<SolverStrategy> strategy) {
+    for (auto& s : strategies) {
+        if (std::string(s->name()) == strategy->name()) {
+            s = std::move(strategy);
+            return;
+        }
+    }
+    strategies.push_back(std::move(strategy));
+}
+
+const SolverStrategy* SolverRegistry::find(const std::string& name) const {
+    for (const auto& s : strategies) {
+        if (name == s->name()) return s.get();
+    }
+    return nullptr;
+}
+
+const SolverStrategy* SolverRegistry::select(const std::string& name, int width, int height,
+                                             const std::vector<Piece>& pieces) const {
+    if (name.empty() || name == "auto") return choose(width, height, pieces);
+    const SolverStrategy* s = find(name);
+    return s && s->supports(width, height) ? s : nullptr;
+}
+
+const SolverStrategy* SolverRegistry::choose(int width, int height, const std::vector<Piece>& pieces) const {
+    const InstanceFeatures f = describe_instance(width, height, pieces);
+    const SolverStrategy* best = nullptr;
+    double best_us = std::numeric_limits<double>::infinity();
+    for (const auto& s : strategies) {
+        if (!s->supports(width, height)) continue;
+        const double us = s->estimate_us(f);
+        if (us < best_us) {
+            best = s.get();
+            best_us = us;
+        }
+    }
+    return best;
+}
+
+std::vector<std::string> SolverRegistry::names() const {
+    std::vector<std::string> out;
+    for (const auto& s : strategies) out.push_back(s->name());
+    return out;
+}
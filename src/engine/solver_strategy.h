@@ -0,0 +1,103 @@
+#ifndef SOLVER_STRATEGY_H
+#define SOLVER_STRATEGY_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "piece.h"
+#include "placement.h"
+#include "search_stats.h"
+
+// Cheap description of an instance, for choosing an engine before solving.
+class InstanceFeatures {
+public:
+    int width = 0;
+    int height = 0;
+    int piece_count = 0;
+    long long placements = 0;       // variant positions inside the board (no overlap test)
+};
+
+InstanceFeatures describe_instance(int width, int height, const std::vector<Piece>& pieces);
+
+// One way of finding a first solution (F8).
+// --------------------------------
+// estimate_us() is a cost model in microseconds: a fixed setup, setup per
+// legal placement (building tables), and time per search node, with the node
+// count itself guessed from the piece count. The constants come from
+// `benchmark --section strategies`, which times every engine on the
+// catalogue and fits them; only their ratios matter for the choice.
+class SolverStrategy {
+public:
+    virtual ~SolverStrategy() = default;
+
+    virtual const char* name() const = 0;
+    virtual bool supports(int width, int height) const = 0;
+    virtual double estimate_us(const InstanceFeatures& f) const = 0;
+
+    // First solution in path (level piece ids, board coordinates).
+    virtual bool solve(int width, int height, const std::vector<Piece>& pieces,
+                       std::vector<Placement>& path) const = 0;
+
+    // solve() that also reports the engine's search counters; engines that
+    // keep none report zeros.
+    virtual bool solve_with_stats(int width, int height, const std::vector<Piece>& pieces,
+                                  std::vector<Placement>& path, SearchStats& stats) const {
+        stats = SearchStats{};
+        return solve(width, height, pieces, path);
+    }
+
+    // solve() that gives up, returning false, once should_stop() is true.
+    // Engines that cannot pause ignore it and search to the end.
+    virtual bool solve_until(int width, int height, const std::vector<Piece>& pieces,
+                             std::vector<Placement>& path, const std::function<bool()>&) const {
+        return solve(width, height, pieces, path);
+    }
+};
+
+// Linear cost model shared by the built-in engines.
+class CostModel {
+public:
+    double setup_us = 0;
+    double per_placement_us = 0;
+    double per_node_us = 0;
+
+    double operator()(const InstanceFeatures& f) const;
+
+    // Guessed search nodes to a first solution: 10^(a + b * pieces), fitted
+    // on the catalogue.
+    static double expected_nodes(const InstanceFeatures& f);
+};
+
+// Engines by name; "auto" picks the supported engine with the lowest
+// estimate. Built-ins, in registration order:
+//   kernel     FixedSolver<W, H> (shipped board shapes)
+//   filter     FilteredSearch, bucket filter (<= 64 cells)
+//   iterative  IterativeSolver, bitmask table (<= 64 cells)
+//   generic    Solver on a Board (any size)
+class SolverRegistry {
+public:
+    static SolverRegistry& instance();
+
+    // Replaces an engine of the same name. Register before serving requests.
+    void add(std::unique_ptr<SolverStrategy> strategy);
+
+    const SolverStrategy* find(const std::string& name) const;
+
+    // "auto" (or empty) chooses; otherwise the named engine if it supports
+    // the board. nullptr when nothing fits.
+    const SolverStrategy* select(const std::string& name, int width, int height,
+                                 const std::vector<Piece>& pieces) const;
+
+    const SolverStrategy* choose(int width, int height, const std::vector<Piece>& pieces) const;
+
+    std::vector<std::string> names() const;
+
+private:
+    SolverRegistry();
+
+    std::vector<std::unique_ptr<SolverStrategy>> strategies;
+};
+
+#endif
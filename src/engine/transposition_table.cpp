@@ -0,0 +1,43 @@
+#include "transposition_table.h"
+
+#include <algorithm>
+
+TranspositionTable::TranspositionTable(size_t budget_bytes) {
+    size_t buckets = 1;
+    while (buckets * 2 * kWays * sizeof(Entry) <= budget_bytes) buckets *= 2;
+    entries.assign(buckets * kWays, Entry{});
+    bucket_mask = buckets - 1;
+}
+
+void TranspositionTable::store(uint64_t occupied, uint64_t pieces, uint64_t count, uint64_t work) {
+    Entry* bucket = &entries[index_of(occupied, pieces)];
+    const uint32_t w = (uint32_t)std::clamp<uint64_t>(work, 1, UINT32_MAX);
+
+    // empty (stale) slots rank below every live one
+    auto rank = [&](const Entry& e) -> uint64_t { return e.generation == generation ? e.work : 0; };
+
+    Entry* victim = &bucket[0];
+    for (int i = 0; i < kWays; ++i) {
+        Entry& e = bucket[i];
+        if (e.generation == generation && e.occupied == occupied && e.pieces == pieces) {
+            victim = &e;    // refresh in place
+            break;
+        }
+        if (rank(e) < rank(*victim)) victim = &e;
+    }
+
+    if (rank(*victim) != 0 && !(victim->occupied == occupied && victim->pieces == pieces)) {
+        ++table_stats.evictions;
+    }
+    ++table_stats.stores;
+    *victim = Entry{occupied, pieces, count, w, generation};
+}
+
+void TranspositionTable::clear() {
+    if (++generation == 0) {
+        // wrapped: stale stamps could look live again
+        std::fill(entries.begin(), entries.end(), Entry{});
+        generation = 1;
+    }
+    table_stats = TranspositionStats{};
+}
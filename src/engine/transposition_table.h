@@ -0,0 +1,85 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Memo of search sub-states for the bitmask engines.
+// --------------------------------
+// The same (occupied cells, pieces left) state is often reached through
+// different placement orders. Its subtree does not depend on how it was
+// reached, so its solution count can be stored once:
+// - count == 0 marks a dead state; the search skips it on the next visit
+// - count > 0 is only known after the full subtree was counted, and lets
+//   count_solutions() add it without searching again
+//
+// Fixed memory: buckets of 4 entries sized from a byte budget. A full bucket
+// replaces its entry with the least work (subtree nodes) behind it, so cheap
+// states are evicted before expensive ones. clear() is O(1).
+//
+// Keys do not include the puzzle instance: clear() before reusing a table for
+// a different board or piece set.
+class TranspositionStats {
+public:
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;     // stores that replaced a live entry
+
+    double hit_rate() const { return probes ? (double)hits / (double)probes : 0.0; }
+};
+
+class TranspositionTable {
+public:
+    // At least one bucket, however small the budget.
+    explicit TranspositionTable(size_t budget_bytes = 16u << 20);
+
+    // true and the stored count when the state is known
+    bool probe(uint64_t occupied, uint64_t pieces, uint64_t& count) {
+        ++table_stats.probes;
+        Entry* bucket = &entries[index_of(occupied, pieces)];
+        for (int i = 0; i < kWays; ++i) {
+            if (bucket[i].generation == generation && bucket[i].occupied == occupied &&
+                bucket[i].pieces == pieces) {
+                ++table_stats.hits;
+                count = bucket[i].count;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // work = nodes spent on the subtree, the eviction priority
+    void store(uint64_t occupied, uint64_t pieces, uint64_t count, uint64_t work);
+
+    void clear();
+
+    size_t capacity() const { return entries.size(); }
+    size_t size_bytes() const { return entries.size() * sizeof(Entry); }
+    const TranspositionStats& stats() const { return table_stats; }
+
+private:
+    static constexpr int kWays = 4;
+
+    struct Entry {
+        uint64_t occupied;
+        uint64_t pieces;
+        uint64_t count;
+        uint32_t work;          // saturates
+        uint32_t generation;    // live only when equal to the table's
+    };
+
+    size_t index_of(uint64_t occupied, uint64_t pieces) const {
+        uint64_t h = occupied * 0x9E3779B97F4A7C15ull ^ (pieces + 0x632BE59BD9B4E019ull) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 29;
+        return (size_t)(h & bucket_mask) * kWays;
+    }
+
+    std::vector<Entry> entries;
+    uint64_t bucket_mask;
+    uint32_t generation = 1;    // clear() bumps it instead of wiping entries
+    TranspositionStats table_stats;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "batch_solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include "../engine/board.h"
+#include "../engine/feasibility.h"
+#include "../engine/solver_strategy.h"
+#include "level_loader.h"
+#include "report_format.h"
+
+namespace fs = std::filesystem;
+
+std::vector<std::string> collect_level_files(const std::string& dir) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (ec) {
+        throw std::runtime_error("Could not read level directory: " + dir + " (" + ec.message() + ")");
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static std::vector<int> render(int width, int height, const std::vector<Piece>& pieces,
+                               const std::vector<Placement>& path) {
+    Board board(width, height);
+    for (const auto& p : path) {
+        auto piece = std::find_if(pieces.begin(), pieces.end(),
+                                  [&](const Piece& x) { return x.get_id() == p.get_piece_id(); });
+        board.place(p.get_piece_id(), piece->get_variants()[p.get_variant_index()], p.get_offset());
+    }
+    return board.get_grid();
+}
+
+BatchLevel solve_level_file(const std::string& path) {
+    const auto start = std::chrono::steady_clock::now();
+
+    BatchLevel lv;
+    const fs::path file(path);
+    lv.path = path;
+    lv.group = file.parent_path().filename().string();
+    lv.level = file.stem().string();
+
+    try {
+        LevelData ld = LevelLoader::load_level(path);
+        lv.width = ld.width;
+        lv.height = ld.height;
+        for (const auto& p : ld.pieces) lv.piece_ids.push_back(p.get_id());
+
+        FeasibilityReport feasibility = check_feasibility(ld.width, ld.height, ld.pieces);
+        if (!feasibility.feasible) {
+            lv.error = feasibility.reason;
+        } else if (const SolverStrategy* engine = SolverRegistry::instance().choose(ld.width, ld.height, ld.pieces)) {
+            std::vector<Placement> solution;
+            lv.engine = engine->name();
+            lv.solved = engine->solve(ld.width, ld.height, ld.pieces, solution);
+            if (lv.solved) lv.grid = render(ld.width, ld.height, ld.pieces, solution);
+        }
+    } catch (const std::exception& e) {
+        lv.error = e.what();
+    }
+
+    lv.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return lv;
+}
+
+std::vector<BatchLevel> solve_level_files(const std::vector<std::string>& paths, unsigned jobs) {
+    std::vector<BatchLevel> levels(paths.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i; (i = next.fetch_add(1)) < paths.size();) {
+            levels[i] = solve_level_file(paths[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const size_t n = std::min<size_t>(std::max(1u, jobs), paths.size());
+    for (size_t t = 1; t < n; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& t : threads) t.join();
+    return levels;
+}
+
+static std::string join(const std::vector<int>& v, const char* sep, size_t from = 0, size_t to = std::string::npos) {
+    std::string out;
+    to = std::min(to, v.size());
+    for (size_t i = from; i < to; ++i) {
+        if (i > from) out += sep;
+        out += std::to_string(v[i]);
+    }
+    return out;
+}
+
+// rows separated by '/', cells by ' '
+static std::string grid_rows(const BatchLevel& lv) {
+    std::string out;
+    for (int y = 0; y < lv.height && !lv.grid.empty(); ++y) {
+        if (y) out += '/';
+        out += join(lv.grid, " ", (size_t)y * lv.width, (size_t)(y + 1) * lv.width);
+    }
+    return out;
+}
+
+void write_batch_csv(std::ostream& out, const std::vector<BatchLevel>& levels) {
+    out << "group,level,width,height,pieces,solved,engine,ms,error,solution\n";
+    for (const auto& lv : levels) {
+        out << csv_field(lv.group) << ',' << csv_field(lv.level) << ',' << lv.width << ',' << lv.height << ','
+            << lv.piece_ids.size() << ',' << lv.solved << ',' << lv.engine << ',' << fixed(lv.ms, 3) << ','
+            << csv_field(lv.error) << ',' << grid_rows(lv) << '\n';
+    }
+}
+
+void write_batch_json(std::ostream& out, const std::vector<BatchLevel>& levels) {
+    out << "{\n  \"levels\": [";
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const BatchLevel& lv = levels[i];
+        out << (i ? ",\n" : "\n") << "    {\"group\": " << json_string(lv.group)
+            << ", \"id\": " << json_string(lv.level) << ", \"width\": " << lv.width
+            << ", \"height\": " << lv.height << ", \"pieceIds\": [" << join(lv.piece_ids, ",") << "]"
+            << ", \"solved\": " << (lv.solved ? "true" : "false") << ", \"ms\": " << fixed(lv.ms, 3);
+        if (!lv.engine.empty()) out << ", \"engine\": " << json_string(lv.engine);
+        if (!lv.error.empty()) out << ", \"error\": " << json_string(lv.error);
+        if (!lv.grid.empty()) {
+            out << ", \"grid\": [";
+            for (int y = 0; y < lv.height; ++y) {
+                out << (y ? ", [" : "[")
+                    << join(lv.grid, ",", (size_t)y * lv.width, (size_t)(y + 1) * lv.width) << "]";
+            }
+            out << "]";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void write_batch_boards(std::ostream& out, const std::vector<BatchLevel>& levels) {
+    for (const auto& lv : levels) {
+        out << lv.group << "/" << lv.level << " (" << lv.width << "x" << lv.height << ", "
+            << lv.piece_ids.size() << " pieces, " << fixed(lv.ms, 3) << " ms): ";
+        if (!lv.error.empty()) {
+            out << "error: " << lv.error << "\n\n";
+            continue;
+        }
+        out << (lv.solved ? "solved" : "no solution") << " by " << lv.engine << "\n";
+        for (int y = 0; y < lv.height && !lv.grid.empty(); ++y) {
+            for (int x = 0; x < lv.width; ++x) {
+                const int v = lv.grid[(size_t)y * lv.width + x];
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "%3s", v < 0 ? "." : std::to_string(v).c_str());
+                out << buf;
+            }
+            out << "\n";
+        }
+        out << "\n";
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../engine/placement.h"
+
+// One level file solved by the batch mode of `game`.
+class BatchLevel {
+public:
+    std::string path;
+    std::string group;              // parent folder
+    std::string level;              // file stem, e.g. levels3
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;
+    bool solved = false;
+    std::string engine;             // SolverRegistry engine that searched
+    std::string error;              // load error or infeasibility reason
+    std::vector<int> grid;          // piece id per cell (row-major), -1 = empty; set when solved
+    double ms = 0;
+
+    bool ok() const { return solved && error.empty(); }
+};
+
+// Non-interactive solving of whole level folders (T6.2).
+// --------------------------------
+// collect_level_files() lists every *.txt below a directory, sorted.
+// solve_level_files() solves them on `jobs` threads (a shared index hands
+// out files, results keep the input order). Each level is checked for
+// feasibility, then solved by the engine SolverRegistry chooses for it.
+std::vector<std::string> collect_level_files(const std::string& dir);
+
+BatchLevel solve_level_file(const std::string& path);
+
+std::vector<BatchLevel> solve_level_files(const std::vector<std::string>& paths, unsigned jobs);
+
+void write_batch_csv(std::ostream& out, const std::vector<BatchLevel>& levels);
+void write_batch_json(std::ostream& out, const std::vector<BatchLevel>& levels);
+void write_batch_boards(std::ostream& out, const std::vector<BatchLevel>& levels);
+
+#endif
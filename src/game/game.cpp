@@ -1,5 +1,6 @@
 #include "game.h"
-#include <format>
+
+#include <algorithm>
 
 Game::Game(int w, int h, std::vector<Piece> pieces) : width(w), height(h), pieces(std::move(pieces)), board(w, h){}
 
@@ -7,18 +8,22 @@ void Game::run() {
     while (true) {
         print_menu();
         int cmd;
-        std::cin >> cmd;
+        if (!(std::cin >> cmd)) break;
 
         if(cmd == 1) {
             print_level_summary();
             int level_choice;
-            std::cout << "Select level (0 to exit): ";
-            std::cin >> level_choice;
+            if (!(std::cin >> level_choice)) break;
+            if (!level_names.count(level_choice)) continue;
 
-            std::string filename;
-            std::cout << "Enter level filename: ";
-            std::cin >> filename;
-            load_level(std::format("../levels/{0}/level{1}/level{2}.txt", level_names[level_choice] ,filename[0], filename[1]));
+            int number;
+            std::cout << "Enter level number: ";
+            if (!(std::cin >> number)) break;
+            try {
+                load_level(level_root + "/" + level_names[level_choice] + "/levels" + std::to_string(number) + ".txt");
+            } catch (const std::exception& e) {
+                std::cout << e.what() << std::endl;
+            }
         } else if (cmd == 2) {
             solve_game();
         } else if (cmd == 3) {
@@ -40,16 +45,9 @@ void Game::print_menu() const {
 
 void Game::print_level_summary() const {
     std::cout << std::endl << "=== Level Summary ===" << std::endl;
-    std::cout << "1. The small slam" << std::endl;
-    std::cout << "2. The slam1" << std::endl;
-    std::cout << "3. The slam2" << std::endl;
-    std::cout << "4. The slam3" << std::endl;
-    std::cout << "5. The slam4" << std::endl;
-    std::cout << "6. The grand slam" << std::endl;
-    std::cout << "7. The super slam1" << std::endl;
-    std::cout << "8. The super slam2" << std::endl;
-    std::cout << "9. The super slam3" << std::endl;
-    std::cout << "10. The super slam4" << std::endl;
+    for (const auto& [number, name] : level_names) {
+        std::cout << number << ". " << name << std::endl;
+    }
     std::cout << "0. Exit" << std::endl;
     std::cout << "Choose: ";
 }
@@ -65,14 +63,16 @@ void Game::print_board() const {
 
 void Game::solve_game() {
     board.clear();
-    Solver solver(board, pieces);
-    
-    if (solver.solve()) {
-        std::cout << "Solved!\n";
+    const SolverStrategy* engine = SolverRegistry::instance().choose(width, height, pieces);
+    std::vector<Placement> path;
+
+    if (engine && engine->solve(width, height, pieces, path)) {
+        std::cout << "Solved! (" << engine->name() << ")\n";
 
         Board show(width, height);
-        for (const auto& p : solver.get_placements_path()) {
-            const Piece& piece = pieces[p.get_piece_id()];
+        for (const auto& p : path) {
+            const Piece& piece = *std::find_if(pieces.begin(), pieces.end(),
+                [&](const Piece& x) { return x.get_id() == p.get_piece_id(); });
             const auto& v = piece.get_variants()[p.get_variant_index()];
             show.place(p.get_piece_id(), v, p.get_offset());
         }
@@ -6,6 +6,7 @@
 #include <map>
 
 #include "../engine/solver.h"
+#include "../engine/solver_strategy.h"
 #include "level_loader.h"
 
 class Game {
@@ -17,6 +18,9 @@ public:
     }
     void run();
 
+    // Folder holding <group>/levelsN.txt for the menu (default: levels).
+    void set_level_root(const std::string& root) { level_root = root; }
+
     void load_level(const std::string& filename);
 
     void print_level_contents() const;
@@ -33,6 +37,9 @@ private:
     
     Board board;
 
+    std::string level_root = "levels";
+
+    // menu number -> group folder
     std::map<int, std::string> level_names {
         {1, "The small slam"},
         {2, "The slam1"},
@@ -40,10 +47,10 @@ private:
         {4, "The slam3"},
         {5, "The slam4"},
         {6, "The grand slam"},
-        {7, "The super slam1"},
-        {8, "The super slam2"},
-        {9, "The super slam3"},
-        {10, "The super slam4"}
+        {7, "The super slam"},
+        {8, "Challenge1"},
+        {9, "Challenge2"},
+        {10, "Challenge3"}
     };
 };
 
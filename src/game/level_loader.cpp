@@ -39,7 +39,6 @@ LevelData LevelLoader::load_level(const std::string& filename) {
         ids.emplace_back(std::stoi(line.substr(position, next - position)));
         position = next + 1;
     }
-    std::cout << "test ids size is: " << ids.size() << std::endl;
     levelData.pieces = PieceLibrary::get_piece_by_id(ids);
     return levelData;
 }
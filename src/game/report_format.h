@@ -0,0 +1,18 @@
+#ifndef REPORT_FORMAT_H
+#define REPORT_FORMAT_H
+
+#include <string>
+
+// Field formatting shared by the CSV / JSON reports of the offline tools
+// (level_analyzer, batch solving).
+
+// Quoted only when it holds a comma, quote or newline; quotes doubled.
+std::string csv_field(const std::string& s);
+
+// Quoted JSON string; quotes, backslashes and control characters escaped.
+std::string json_string(const std::string& s);
+
+// printf "%.*f".
+std::string fixed(double v, int digits);
+
+#endif
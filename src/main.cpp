@@ -1,31 +1,128 @@
+// game
+// --------------------------------
+// Interactive puzzle menu, or a batch solver for whole level folders.
+//
+//   game [--levels DIR]
+//   game --solve-dir DIR [--jobs N] [--format csv|json|board] [--output FILE]
+//
+// --levels     level root for the interactive menu (default: levels)
+// --solve-dir  solve every *.txt below DIR and report each level's solution
+//              and time instead of starting the menu
+// --jobs       worker threads (default: hardware concurrency)
+// --format     board (default), csv or json
+// --output     write there instead of stdout (T6.2)
+//
+// Batch mode exits with 1 when any level fails to load or has no solution,
+// so catalogue-wide checks can run from scripts.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
-// #include "./engine/board.h"
-// #include "./engine/piece.h"
-// #include "./engine/solver.h"
-// #include "./game/game.h"
-#include "./web/solve_api.h"
-
-int main() {
-    SolveRequest request;
-    request.width = 4;
-    request.height = 5;
-    request.piece_ids = {0, 1, 2, 3};
-
-    auto result = solve_puzzle(request);
-    if (result.solved) {
-        std::cout << "placements = " << result.placements.size() << "\n";
-        if (!result.placements.empty()) {
-            const auto& p = result.placements[0];
-            std::cout << "pieceId = " << p.pieceId << ", cells = " << 5 << std::endl;
-            for (const auto& p : result.placements) {   
-                for (const auto& c : p.cells) {   
-                    std::cout << "(" << c.x << "," << c.y << ") ";
-                }
-                std::cout << std::endl;
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "./game/batch_solver.h"
+#include "./game/game.h"
+
+static void usage() {
+    std::cerr << "usage: game [--levels DIR]\n"
+                 "       game --solve-dir DIR [--jobs N] [--format csv|json|board] [--output FILE]\n";
+}
+
+static int run_batch(const std::string& dir, unsigned jobs, const std::string& format, const std::string& output) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> files;
+    try {
+        files = collect_level_files(dir);
+    } catch (const std::exception& e) {
+        std::cerr << "[BATCH] " << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<BatchLevel> levels = solve_level_files(files, jobs);
+
+    std::ostringstream body;
+    if (format == "csv") {
+        write_batch_csv(body, levels);
+    } else if (format == "json") {
+        write_batch_json(body, levels);
+    } else {
+        write_batch_boards(body, levels);
+    }
+
+    if (output.empty()) {
+        std::cout << body.str();
+    } else {
+        std::ofstream out(output, std::ios::trunc);
+        out << body.str();
+        if (!out) {
+            std::cerr << "[BATCH] could not write " << output << "\n";
+            return 1;
+        }
+    }
+
+    size_t failures = 0;
+    double search_ms = 0;
+    for (const auto& lv : levels) {
+        search_ms += lv.ms;
+        if (!lv.ok()) {
+            ++failures;
+            std::cerr << "[BATCH] " << lv.path << " [FAIL] " << (lv.error.empty() ? "no solution" : lv.error) << "\n";
+        }
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cerr << "[BATCH] levels=" << levels.size() << " solved=" << levels.size() - failures
+              << " failures=" << failures << " jobs=" << jobs << " (" << ms << " ms wall, "
+              << (long long)search_ms << " ms search)\n";
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    std::string levels_dir = "levels";
+    std::string solve_dir;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::string format = "board";
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--levels" && i + 1 < argc) {
+            levels_dir = argv[++i];
+        } else if (arg == "--solve-dir" && i + 1 < argc) {
+            solve_dir = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            try {
+                jobs = (unsigned)std::max(1, std::stoi(argv[++i]));
+            } catch (const std::exception&) {   // not a number, or out of int range
+                usage();
+                return 2;
             }
+        } else if (arg == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            usage();
+            return 2;
         }
-    } else {
-        std::cout << "solved = false, error = " << result.error_message << std::endl;
     }
+    if (format != "board" && format != "csv" && format != "json") {
+        usage();
+        return 2;
+    }
+
+    if (!solve_dir.empty()) {
+        return run_batch(solve_dir, jobs, format, output);
+    }
+
+    Game game(0, 0, {});
+    game.set_level_root(levels_dir);
+    game.run();
     return 0;
 }
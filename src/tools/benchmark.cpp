@@ -0,0 +1,677 @@
+// benchmark
+// --------------------------------
+// Solver timings on the level catalogue and a few larger custom boards.
+//
+//   benchmark [levels_dir] [--section kernels|iterative|memo|portfolio|filter|stream|strategies|
+//                                    frontier|perf]
+//             [--memo-mb N] [--memo-min-left N] [--portfolio-threads N]
+//
+// Every section prints one table; run from the build directory the default
+// levels_dir is ../levels.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../engine/board.h"
+#include "../engine/candidate_filter.h"
+#include "../engine/frontier_counter.h"
+#include "../engine/iterative_solver.h"
+#include "../engine/kernel_dispatch.h"
+#include "../engine/perf_counters.h"
+#include "../engine/piece_library.h"
+#include "../engine/portfolio_solver.h"
+#include "../engine/solution_stream.h"
+#include "../engine/solver_strategy.h"
+#include "../engine/solver.h"
+#include "../engine/transposition_table.h"
+#include "../game/level_loader.h"
+
+namespace fs = std::filesystem;
+
+struct BenchLevel {
+    std::string name;
+    int width = 0;
+    int height = 0;
+    std::vector<Piece> pieces;
+    bool count = true;      // also time full enumeration
+};
+
+static std::vector<BenchLevel> load_levels(const fs::path& root) {
+    std::vector<BenchLevel> out;
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    for (const auto& f : files) {
+        LevelData ld = LevelLoader::load_level(f.string());
+        out.push_back(BenchLevel{f.parent_path().filename().string() + "/" + f.stem().string(),
+                                 ld.width, ld.height, ld.pieces});
+    }
+    return out;
+}
+
+// All 12 pentominoes on the classic rectangles; first solution only.
+static std::vector<BenchLevel> custom_levels() {
+    std::vector<BenchLevel> out;
+    for (auto [w, h] : std::vector<std::pair<int, int>>{{10, 6}, {12, 5}, {15, 4}}) {
+        out.push_back(BenchLevel{"all12-" + std::to_string(w) + "x" + std::to_string(h),
+                                 w, h, PieceLibrary::make_all_pieces(), false});
+    }
+    return out;
+}
+
+// Run fn until at least min_ms elapsed; returns microseconds per call.
+static double time_us(const std::function<void()>& fn, double min_ms = 50.0) {
+    using clock = std::chrono::steady_clock;
+    int reps = 0;
+    const auto start = clock::now();
+    double elapsed_ms = 0.0;
+    do {
+        fn();
+        ++reps;
+        elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    } while (elapsed_ms < min_ms);
+    return elapsed_ms * 1000.0 / reps;
+}
+
+static std::string shape_of(const BenchLevel& lv) {
+    return std::to_string(lv.width) + "x" + std::to_string(lv.height);
+}
+
+// Generic Solver vs FixedSolver<W, H>, per board shape.
+static void bench_kernels(const std::vector<BenchLevel>& levels) {
+    struct Row { int levels = 0; double generic_us = 0, kernel_us = 0; };
+    std::map<std::string, Row> rows;
+
+    for (const auto& lv : levels) {
+        const SolverKernel* kernel = find_kernel(lv.width, lv.height);
+        if (!kernel) continue;
+
+        auto generic = [&] {
+            Board board(lv.width, lv.height);
+            Solver solver(board, lv.pieces);
+            solver.solve();
+            if (lv.count) {
+                board.clear();
+                solver.count_solutions();
+            }
+        };
+        auto fixed = [&] {
+            std::vector<Placement> path;
+            kernel->solve(lv.pieces, path);
+            if (lv.count) kernel->count(lv.pieces, 0);
+        };
+
+        Row& row = rows[shape_of(lv) + (lv.count ? "" : " (first)")];
+        row.levels += 1;
+        row.generic_us += time_us(generic);
+        row.kernel_us += time_us(fixed);
+    }
+
+    std::printf("%-18s %7s %14s %14s %9s\n", "shape", "levels", "generic_us", "kernel_us", "speedup");
+    for (const auto& [shape, row] : rows) {
+        std::printf("%-18s %7d %14.1f %14.1f %8.1fx\n", shape.c_str(), row.levels,
+                    row.generic_us, row.kernel_us, row.generic_us / row.kernel_us);
+    }
+}
+
+// Full enumeration node throughput: recursive Solver, FixedSolver<W, H> and
+// the explicit-stack IterativeSolver walk the same tree.
+static void bench_iterative(const std::vector<BenchLevel>& levels) {
+    struct Row { int levels = 0; uint64_t nodes = 0; double generic_us = 0, kernel_us = 0, iterative_us = 0; };
+    std::map<std::string, Row> rows;
+
+    for (const auto& lv : levels) {
+        if (!lv.count || !PlacementTable::supports(lv.width, lv.height)) continue;
+        const SolverKernel* kernel = find_kernel(lv.width, lv.height);
+
+        IterativeSolver probe(lv.width, lv.height, lv.pieces);
+        probe.count_solutions();
+
+        Row& row = rows[shape_of(lv)];
+        row.levels += 1;
+        row.nodes += probe.get_stats().nodes;
+        row.generic_us += time_us([&] {
+            Board board(lv.width, lv.height);
+            Solver solver(board, lv.pieces);
+            solver.count_solutions();
+        });
+        if (kernel) row.kernel_us += time_us([&] { kernel->count(lv.pieces, 0); });
+        row.iterative_us += time_us([&] {
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            solver.count_solutions();
+        });
+    }
+
+    std::printf("%-8s %7s %12s %14s %14s %14s\n", "shape", "levels", "nodes",
+                "generic_Mn/s", "kernel_Mn/s", "iterative_Mn/s");
+    for (const auto& [shape, row] : rows) {
+        std::printf("%-8s %7d %12llu %14.1f %14.1f %14.1f\n", shape.c_str(), row.levels,
+                    (unsigned long long)row.nodes, row.nodes / row.generic_us,
+                    row.kernel_us > 0 ? row.nodes / row.kernel_us : 0.0, row.nodes / row.iterative_us);
+    }
+}
+
+// Full enumeration with and without the transposition table, per level, so
+// it shows where memoizing sub-states pays off. Adds full counts of all 12
+// pentominoes on the narrow rectangles (row-major search, so narrow is fast).
+static void bench_memo(std::vector<BenchLevel> levels, size_t budget_bytes, int min_left) {
+    for (auto [w, h] : std::vector<std::pair<int, int>>{{3, 20}, {4, 15}, {5, 12}, {6, 10}}) {
+        levels.push_back(BenchLevel{"all12-" + std::to_string(w) + "x" + std::to_string(h),
+                                    w, h, PieceLibrary::make_all_pieces(), true});
+    }
+
+    std::printf("%-24s %8s %12s %12s %12s %8s %9s %8s\n", "level", "shape", "plain_us", "memo_us",
+                "memo_nodes", "hit%", "evicted", "speedup");
+
+    TranspositionTable memo(budget_bytes);
+    double plain_total = 0, memo_total = 0;
+
+    for (const auto& lv : levels) {
+        if (!lv.count || !PlacementTable::supports(lv.width, lv.height)) continue;
+
+        const double plain_us = time_us([&] {
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            solver.count_solutions();
+        });
+
+        uint64_t memo_nodes = 0;
+        const double memo_us = time_us([&] {
+            memo.clear();
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            solver.set_transposition_table(&memo, min_left);
+            solver.count_solutions();
+            memo_nodes = solver.get_stats().nodes;
+        });
+
+        const auto& st = memo.stats();
+        plain_total += plain_us;
+        memo_total += memo_us;
+        std::printf("%-24s %8s %12.1f %12.1f %12llu %7.1f%% %9llu %7.2fx\n", lv.name.c_str(),
+                    shape_of(lv).c_str(), plain_us, memo_us, (unsigned long long)memo_nodes,
+                    100.0 * st.hit_rate(), (unsigned long long)st.evictions, plain_us / memo_us);
+    }
+    std::printf("%-24s %8s %12.1f %12.1f %12s %8s %9s %7.2fx\n", "total", "", plain_total, memo_total,
+                "", "", "", plain_total / memo_total);
+}
+
+// First-solution latency: the /solve order alone vs a portfolio race. Lists
+// the levels where either takes over a millisecond, then the latency
+// percentiles over all levels and which strategy won how often.
+static void bench_portfolio(const std::vector<BenchLevel>& levels, int threads) {
+    std::vector<double> single, raced;
+    std::map<std::string, int> wins;
+
+    std::printf("%-24s %8s %12s %12s %s\n", "level", "shape", "single_us", "portfolio_us", "winner");
+    for (const auto& lv : levels) {
+        if (!PlacementTable::supports(lv.width, lv.height)) continue;
+
+        PortfolioOptions one;
+        one.threads = 1;
+        PortfolioOptions many;
+        many.threads = threads;
+
+        const double single_us = time_us([&] { solve_portfolio(lv.width, lv.height, lv.pieces, one); }, 20.0);
+        PortfolioResult r;
+        const double raced_us = time_us([&] { r = solve_portfolio(lv.width, lv.height, lv.pieces, many); }, 20.0);
+
+        single.push_back(single_us);
+        raced.push_back(raced_us);
+        ++wins[to_string(r.winner)];
+        if (single_us > 1000.0 || raced_us > 1000.0) {
+            std::printf("%-24s %8s %12.1f %12.1f %s\n", lv.name.c_str(), shape_of(lv).c_str(),
+                        single_us, raced_us, to_string(r.winner));
+        }
+    }
+
+    auto pct = [](std::vector<double> v, double q) {
+        std::sort(v.begin(), v.end());
+        return v.empty() ? 0.0 : v[std::min(v.size() - 1, (size_t)(q * (double)v.size()))];
+    };
+    std::printf("%-24s %8s %12.1f %12.1f\n", "p50", "", pct(single, 0.50), pct(raced, 0.50));
+    std::printf("%-24s %8s %12.1f %12.1f\n", "p99", "", pct(single, 0.99), pct(raced, 0.99));
+    std::printf("%-24s %8s %12.1f %12.1f\n", "max", "", pct(single, 1.0), pct(raced, 1.0));
+    for (const auto& [name, n] : wins) std::printf("  won %-22s %d\n", name.c_str(), n);
+}
+
+// The 12-piece boards: Solver (Board::can_place per candidate), the bitmask
+// IterativeSolver (one mask test per candidate) and FilteredSearch with the
+// scalar and AVX2 bucket filters. First solution on the wide boards, full
+// count on the narrow ones.
+static void bench_filter() {
+    struct Case { int w, h; bool count; };
+    const std::vector<Case> cases = {{10, 6, false}, {12, 5, false}, {15, 4, false},
+                                     {3, 20, true}, {4, 15, true}, {5, 12, true}, {6, 10, true}};
+    const std::vector<Piece> pieces = PieceLibrary::make_all_pieces();
+    const bool avx2 = detect_filter_kernel() == FilterKernel::Avx2;
+
+    std::printf("%-16s %12s %12s %12s %12s %12s %8s\n", "board", "nodes", "can_place_us",
+                "iterative_us", "scalar_us", "avx2_us", "fit%");
+    for (const auto& c : cases) {
+        PlacementTable table(c.w, c.h, pieces);
+
+        const double generic_us = time_us([&] {
+            Board board(c.w, c.h);
+            Solver solver(board, pieces);
+            if (c.count) solver.count_solutions(); else solver.solve();
+        });
+        const double iterative_us = time_us([&] {
+            IterativeSolver solver(c.w, c.h, pieces);
+            if (c.count) solver.count_solutions(); else solver.solve();
+        });
+
+        FilteredSearch scalar(table, FilterKernel::Scalar);
+        const double scalar_us = time_us([&] { if (c.count) scalar.count_solutions(); else scalar.solve(); });
+        double avx2_us = 0;
+        if (avx2) {
+            FilteredSearch vec(table, FilterKernel::Avx2);
+            avx2_us = time_us([&] { if (c.count) vec.count_solutions(); else vec.solve(); });
+        }
+
+        const SearchStats& st = scalar.get_stats();
+        const std::string name = std::to_string(c.w) + "x" + std::to_string(c.h) + (c.count ? " count" : " first");
+        std::printf("%-16s %12llu %12.1f %12.1f %12.1f %12.1f %7.1f%%\n", name.c_str(),
+                    (unsigned long long)st.nodes, generic_us, iterative_us, scalar_us, avx2_us,
+                    100.0 * (double)st.nodes / (double)st.placement_tests);
+    }
+    if (!avx2) std::printf("(no AVX2 on this CPU)\n");
+}
+
+// Full enumeration of 10x6 boards with repeated pieces (tens of thousands of
+// solutions each), solutions kept as std::vector<Placement> in memory vs
+// streamed to a solution file by the writer thread. The search alone
+// (count) is the floor.
+static void bench_stream() {
+    struct Collect : SolutionSink {
+        const PlacementTable& table;
+        std::vector<std::vector<Placement>> all;
+        explicit Collect(const PlacementTable& t) : table(t) {}
+        void on_solution(const uint16_t* decisions, size_t count) override {
+            std::vector<Placement> path;
+            uint64_t occupied = 0;
+            for (size_t d = 0; d < count; ++d) {
+                const uint32_t k = table.bucket_begin(PlacementTable::first_empty(occupied)) + decisions[d];
+                path.push_back(table.to_placement(k));
+                occupied |= table.at(k).mask;
+            }
+            all.push_back(std::move(path));
+        }
+    };
+
+    const std::vector<std::vector<int>> cases = {
+        {3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0},
+        {3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0},
+        {3, 3, 3, 3, 0, 0, 0, 0, 8, 8, 8, 8},
+    };
+    const fs::path file = fs::temp_directory_path() / "benchmark_solutions.bin";
+
+    std::printf("%-28s %10s %10s %10s %10s %14s %12s\n", "pieces (10x6)", "solutions", "count_ms",
+                "vector_ms", "stream_ms", "vector_bytes", "file_bytes");
+    for (const auto& ids : cases) {
+        const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(ids);
+        IterativeSolver solver(10, 6, pieces);
+        uint64_t solutions = 0;
+        const double count_us = time_us([&] { solutions = solver.count_solutions(); }, 1);
+
+        size_t vector_bytes = 0;
+        const double vector_us = time_us([&] {
+            Collect sink(solver.get_table());
+            solver.enumerate(sink);
+            vector_bytes = sink.all.size() * (sizeof(std::vector<Placement>) + ids.size() * sizeof(Placement));
+        }, 1);
+
+        const double stream_us = time_us([&] {
+            SolutionFileWriter writer(file.string(), solver.get_table(), ids);
+            solver.enumerate(writer);
+            writer.close();
+        }, 1);
+
+        std::string name;
+        for (int id : ids) name += std::to_string(id);
+        std::printf("%-28s %10llu %10.1f %10.1f %10.1f %14zu %12llu\n", name.c_str(),
+                    (unsigned long long)solutions, count_us / 1000.0, vector_us / 1000.0,
+                    stream_us / 1000.0, vector_bytes, (unsigned long long)fs::file_size(file));
+    }
+    fs::remove(file);
+}
+
+// Least squares for y ~ X b with three columns (normal equations), rows
+// weighted by w. With nonnegative, columns whose coefficient comes out
+// negative are dropped and the rest refitted.
+static std::vector<double> fit3(const std::vector<std::array<double, 3>>& x, const std::vector<double>& y,
+                                const std::vector<double>& w, bool nonnegative = true) {
+    bool used[3] = {true, true, true};
+    std::vector<double> b(3);
+    for (int round = 0; round < 3; ++round) {
+        double a[3][4] = {};
+        for (size_t i = 0; i < x.size(); ++i) {
+            for (int r = 0; r < 3; ++r) {
+                for (int c = 0; c < 3; ++c) a[r][c] += w[i] * x[i][r] * x[i][c];
+                a[r][3] += w[i] * x[i][r] * y[i];
+            }
+        }
+        for (int r = 0; r < 3; ++r) {
+            if (used[r]) continue;
+            for (int c = 0; c < 3; ++c) a[r][c] = a[c][r] = 0;
+            a[r][3] = 0;
+            a[r][r] = 1;
+        }
+        for (int c = 0; c < 3; ++c) {
+            int p = c;
+            for (int r = c + 1; r < 3; ++r) if (std::abs(a[r][c]) > std::abs(a[p][c])) p = r;
+            std::swap(a[c], a[p]);
+            if (a[c][c] == 0) continue;
+            for (int r = 0; r < 3; ++r) {
+                if (r == c) continue;
+                const double f = a[r][c] / a[c][c];
+                for (int k = c; k < 4; ++k) a[r][k] -= f * a[c][k];
+            }
+        }
+        bool negative = false;
+        for (int r = 0; r < 3; ++r) {
+            b[r] = a[r][r] == 0 ? 0 : a[r][3] / a[r][r];
+            if (nonnegative && b[r] < 0) {
+                used[r] = false;
+                negative = true;
+            }
+        }
+        if (!negative) break;
+    }
+    if (nonnegative) for (double& v : b) v = std::max(0.0, v);
+    return b;
+}
+
+// Every registered engine on every level (first solution), the constants
+// for solver_strategy.cpp fitted from those times, and how "auto" does.
+static void bench_strategies(const std::vector<BenchLevel>& levels) {
+    const SolverRegistry& registry = SolverRegistry::instance();
+    const std::vector<std::string> names = registry.names();
+
+    struct Sample { InstanceFeatures f; double nodes; std::vector<double> us; std::string chosen; };
+    std::vector<Sample> samples;
+    for (const auto& lv : levels) {
+        Sample s;
+        s.f = describe_instance(lv.width, lv.height, lv.pieces);
+        IterativeSolver probe(lv.width, lv.height, lv.pieces);
+        probe.solve();
+        s.nodes = (double)probe.get_stats().nodes;
+        for (const auto& name : names) {
+            const SolverStrategy* engine = registry.find(name);
+            if (!engine->supports(lv.width, lv.height)) {
+                s.us.push_back(-1);
+                continue;
+            }
+            s.us.push_back(time_us([&] {
+                std::vector<Placement> path;
+                engine->solve(lv.width, lv.height, lv.pieces, path);
+            }, 20));
+        }
+        s.chosen = registry.choose(lv.width, lv.height, lv.pieces)->name();
+        samples.push_back(std::move(s));
+    }
+
+    // node guess from the piece count
+    std::vector<std::array<double, 3>> xs;
+    std::vector<double> ys;
+    for (const auto& s : samples) {
+        xs.push_back({1.0, (double)s.f.piece_count, 0.0});
+        ys.push_back(std::log10(std::max(1.0, s.nodes)));
+    }
+    const std::vector<double> nodes_fit = fit3(xs, ys, std::vector<double>(ys.size(), 1.0), false);
+    std::printf("nodes: log10(nodes) = %.3f + %.3f * pieces\n", nodes_fit[0], nodes_fit[1]);
+
+    std::printf("%-10s %10s %14s %12s %12s %8s\n", "engine", "setup_us", "placement_us", "node_us",
+                "total_ms", "fastest");
+    double auto_ms = 0, best_ms = 0;
+    std::vector<int> fastest(names.size(), 0);
+    for (const auto& s : samples) {
+        double best = -1;
+        size_t best_i = 0;
+        for (size_t e = 0; e < names.size(); ++e) {
+            if (s.us[e] >= 0 && (best < 0 || s.us[e] < best)) {
+                best = s.us[e];
+                best_i = e;
+            }
+            if (names[e] == s.chosen) auto_ms += s.us[e] / 1000.0;
+        }
+        ++fastest[best_i];
+        best_ms += best / 1000.0;
+    }
+    for (size_t e = 0; e < names.size(); ++e) {
+        std::vector<std::array<double, 3>> x;
+        std::vector<double> y, w;
+        double total_ms = 0;
+        for (const auto& s : samples) {
+            if (s.us[e] < 0) continue;
+            x.push_back({1.0, (double)s.f.placements, s.nodes});
+            y.push_back(s.us[e]);
+            w.push_back(1.0 / (s.us[e] * s.us[e]));     // relative error
+            total_ms += s.us[e] / 1000.0;
+        }
+        const std::vector<double> c = fit3(x, y, w);
+        std::printf("%-10s %10.3f %14.5f %12.5f %12.2f %8d\n", names[e].c_str(), c[0], c[1], c[2],
+                    total_ms, fastest[e]);
+    }
+    int hits = 0;
+    for (const auto& s : samples) {
+        size_t best_i = 0;
+        for (size_t e = 0; e < names.size(); ++e) {
+            if (s.us[e] >= 0 && (s.us[best_i] < 0 || s.us[e] < s.us[best_i])) best_i = e;
+        }
+        hits += names[best_i] == s.chosen;
+    }
+    std::printf("auto: %.2f ms total (best possible %.2f ms), fastest engine picked on %d of %zu levels\n",
+                auto_ms, best_ms, hits, samples.size());
+}
+
+// Full counts: search (recursive Solver, IterativeSolver) vs the frontier
+// DP, per board shape, checking that all three agree. Adds all 12
+// pentominoes on the narrow rectangles, against the IterativeSolver only.
+static void bench_frontier(std::vector<BenchLevel> levels) {
+    for (auto [w, h] : std::vector<std::pair<int, int>>{{20, 3}, {15, 4}, {12, 5}, {10, 6}}) {
+        levels.push_back(BenchLevel{"all12-" + std::to_string(w) + "x" + std::to_string(h),
+                                    w, h, PieceLibrary::make_all_pieces(), true});
+    }
+
+    struct Row { int levels = 0; uint64_t solutions = 0; size_t peak_states = 0;
+                 double generic_us = 0, iterative_us = 0, frontier_us = 0; };
+    std::map<std::string, Row> rows;
+    int mismatches = 0;
+
+    for (const auto& lv : levels) {
+        if (!lv.count || !FrontierCounter::supports(lv.width, lv.height, lv.pieces) ||
+            !PlacementTable::supports(lv.width, lv.height)) continue;
+        const bool custom = lv.name.rfind("all12-", 0) == 0;
+
+        FrontierCounter counter(lv.width, lv.height, lv.pieces);
+        uint64_t expected = 0, counted = 0, generic = 0;
+
+        Row& row = rows[custom ? lv.name : shape_of(lv)];
+        row.levels += 1;
+        row.iterative_us += time_us([&] {
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            expected = solver.count_solutions();
+        }, 10.0);
+        row.solutions += expected;
+        generic = expected;
+        if (!custom) {
+            row.generic_us += time_us([&] {
+                Board board(lv.width, lv.height);
+                Solver solver(board, lv.pieces);
+                generic = solver.count_solutions();
+            }, 10.0);
+        }
+        row.frontier_us += time_us([&] { counted = counter.count(); }, 10.0);
+        row.peak_states = std::max(row.peak_states, counter.get_peak_states());
+
+        if (counted != expected || generic != expected) {
+            ++mismatches;
+            std::printf("MISMATCH %s: iterative %llu, generic %llu, frontier %llu\n", lv.name.c_str(),
+                        (unsigned long long)expected, (unsigned long long)generic, (unsigned long long)counted);
+        }
+    }
+
+    std::printf("%-14s %7s %10s %12s %14s %14s %12s %9s\n", "shape", "levels", "solutions", "generic_us",
+                "iterative_us", "frontier_us", "peak_states", "speedup");
+    for (const auto& [shape, row] : rows) {
+        std::printf("%-14s %7d %10llu %12.1f %14.1f %14.1f %12zu %8.1fx\n", shape.c_str(), row.levels,
+                    (unsigned long long)row.solutions, row.generic_us, row.iterative_us, row.frontier_us,
+                    row.peak_states, row.iterative_us / row.frontier_us);
+    }
+    std::printf("%d mismatches\n", mismatches);
+}
+
+// Hardware counters per search node and per placement test, for the two
+// engines that count their search; first solutions and full counts over the
+// catalogue (counts on the shipped levels only). Where perf_event_open is
+// refused (containers, VMs without a PMU) the missing events print as "-".
+static void bench_perf(const std::vector<BenchLevel>& levels) {
+    PerfCounters counters;
+    if (!counters.available()) {
+        std::printf("perf counters unavailable: %s\n", counters.reason().c_str());
+        return;
+    }
+    if (!counters.hardware_available()) {
+        std::printf("hardware counters unavailable (%s); software task clock only\n", counters.reason().c_str());
+    }
+
+    using Run = std::function<SearchStats(const BenchLevel&)>;
+    const std::vector<std::pair<std::string, Run>> runs = {
+        {"iterative first", [](const BenchLevel& lv) {
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            solver.solve();
+            return solver.get_stats();
+        }},
+        {"filter first", [](const BenchLevel& lv) {
+            PlacementTable table(lv.width, lv.height, lv.pieces);
+            FilteredSearch search(table);
+            search.solve();
+            return search.get_stats();
+        }},
+        {"iterative count", [](const BenchLevel& lv) {
+            if (!lv.count) return SearchStats{};
+            IterativeSolver solver(lv.width, lv.height, lv.pieces);
+            solver.count_solutions();
+            return solver.get_stats();
+        }},
+        {"filter count", [](const BenchLevel& lv) {
+            if (!lv.count) return SearchStats{};
+            PlacementTable table(lv.width, lv.height, lv.pieces);
+            FilteredSearch search(table);
+            search.count_solutions();
+            return search.get_stats();
+        }},
+    };
+
+    auto cell = [](const PerfReport& r, PerfEvent e, double value) {
+        char buf[32];
+        if (!r.sample.has(e)) return std::string("-");
+        std::snprintf(buf, sizeof(buf), "%.2f", value);
+        return std::string(buf);
+    };
+
+    std::printf("%-16s %12s %12s %10s %10s %6s %10s %10s %10s %10s %9s\n", "run", "nodes", "tests",
+                "cyc/node", "ins/node", "ipc", "l1d/node", "llc/node", "brm/node", "brm/test", "ns/node");
+    for (const auto& [name, run] : runs) {
+        PerfReport report;
+        for (const auto& lv : levels) {
+            if (!PlacementTable::supports(lv.width, lv.height)) continue;
+            counters.start();
+            const SearchStats stats = run(lv);
+            report.sample += counters.stop();
+            report.stats.nodes += stats.nodes;
+            report.stats.placement_tests += stats.placement_tests;
+        }
+        std::printf("%-16s %12llu %12llu %10s %10s %6s %10s %10s %10s %10s %9s\n", name.c_str(),
+                    (unsigned long long)report.stats.nodes, (unsigned long long)report.stats.placement_tests,
+                    cell(report, PerfEvent::Cycles, report.per_node(PerfEvent::Cycles)).c_str(),
+                    cell(report, PerfEvent::Instructions, report.per_node(PerfEvent::Instructions)).c_str(),
+                    cell(report, PerfEvent::Cycles, report.ipc()).c_str(),
+                    cell(report, PerfEvent::L1dMisses, report.per_node(PerfEvent::L1dMisses)).c_str(),
+                    cell(report, PerfEvent::LlcMisses, report.per_node(PerfEvent::LlcMisses)).c_str(),
+                    cell(report, PerfEvent::BranchMisses, report.per_node(PerfEvent::BranchMisses)).c_str(),
+                    cell(report, PerfEvent::BranchMisses, report.per_test(PerfEvent::BranchMisses)).c_str(),
+                    cell(report, PerfEvent::TaskClock, report.per_node(PerfEvent::TaskClock)).c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    fs::path root = "../levels";
+    std::string section = "all";
+    size_t memo_mb = 64;
+    int memo_min_left = 3;
+    int portfolio_threads = kPortfolioStrategies;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--section" && i + 1 < argc) {
+            section = argv[++i];
+        } else if (arg == "--memo-mb" && i + 1 < argc) {
+            memo_mb = std::stoul(argv[++i]);
+        } else if (arg == "--memo-min-left" && i + 1 < argc) {
+            memo_min_left = std::stoi(argv[++i]);
+        } else if (arg == "--portfolio-threads" && i + 1 < argc) {
+            portfolio_threads = std::stoi(argv[++i]);
+        } else {
+            root = arg;
+        }
+    }
+
+    std::vector<BenchLevel> levels = load_levels(root);
+    for (auto& lv : custom_levels()) levels.push_back(std::move(lv));
+    std::cout << "levels=" << levels.size() << "\n";
+
+    if (section == "all" || section == "kernels") {
+        std::cout << "\n== kernels: generic Solver vs FixedSolver<W, H> (solve + count) ==\n";
+        bench_kernels(levels);
+    }
+    if (section == "all" || section == "iterative") {
+        std::cout << "\n== iterative: enumeration throughput, million nodes / s ==\n";
+        bench_iterative(levels);
+    }
+    if (section == "all" || section == "memo") {
+        std::cout << "\n== memo: full count with a " << memo_mb << " MB transposition table, "
+                  << "probed with >= " << memo_min_left << " pieces left ==\n";
+        bench_memo(levels, memo_mb << 20, memo_min_left);
+    }
+    if (section == "all" || section == "portfolio") {
+        std::cout << "\n== portfolio: first solution, table order alone vs " << portfolio_threads
+                  << " racing strategies ==\n";
+        bench_portfolio(levels, portfolio_threads);
+    }
+    if (section == "all" || section == "filter") {
+        std::cout << "\n== filter: all 12 pieces, per-candidate tests vs bucket filter ("
+                  << to_string(detect_filter_kernel()) << " detected) ==\n";
+        bench_filter();
+    }
+    if (section == "all" || section == "stream") {
+        std::cout << "\n== stream: full enumeration, every solution kept in memory vs written to a file ==\n";
+        bench_stream();
+    }
+    if (section == "all" || section == "strategies") {
+        std::cout << "\n== strategies: first solution per engine, fitted cost model, auto selection ==\n";
+        bench_strategies(levels);
+    }
+    if (section == "all" || section == "frontier") {
+        std::cout << "\n== frontier: full count, search vs frontier DP ==\n";
+        bench_frontier(levels);
+    }
+    if (section == "all" || section == "perf") {
+        std::cout << "\n== perf: hardware counters per search node and per placement test ==\n";
+        bench_perf(levels);
+    }
+    return 0;
+}
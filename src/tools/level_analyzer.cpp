@@ -0,0 +1,234 @@
+// level_analyzer
+// --------------------------------
+// Search statistics and a difficulty rating for every level under
+// levels/<group>/*.txt, computed on all cores.
+//
+//   level_analyzer <levels_dir> [--jobs N] [--format csv|json] [--output FILE] [--limit N]
+//
+// --jobs    worker threads (default: hardware concurrency)
+// --format  csv (default) or json
+// --output  write there instead of stdout; the server reads the CSV back
+//           through LEVEL_ANALYSIS=FILE to add difficulty to /groups
+// --limit   stop counting at N solutions per level (0 = all); the
+//           total_solutions column still has the exact count of a level cut
+//           short when the frontier DP can count it (empty otherwise)
+//
+// Levels differ in cost by orders of magnitude, so the unit of work is a
+// LevelAnalyzer branch, not a level: a slow level is spread over every
+// worker instead of keeping one busy while the others idle.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine/frontier_counter.h"
+#include "../engine/level_analysis.h"
+#include "../engine/piece_library.h"
+#include "../engine/solution_count.h"
+#include "../game/level_loader.h"
+#include "../game/report_format.h"
+
+namespace fs = std::filesystem;
+
+static void usage() {
+    std::cerr << "usage: level_analyzer <levels_dir> [--jobs N] [--format csv|json] [--output FILE] [--limit N]\n";
+}
+
+struct Level {
+    std::string group;
+    std::string id;
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;
+    std::unique_ptr<LevelAnalyzer> analyzer;
+    std::vector<BranchStats> branches;
+    LevelAnalysis result;
+    bool total_known = false;       // total_solutions is exact
+    uint64_t total_solutions = 0;
+};
+
+struct Task {
+    size_t level;
+    size_t branch;
+};
+
+static void write_csv(std::ostream& out, const std::vector<Level>& levels) {
+    out << "group,level,width,height,pieces,feasible,solvable,solutions,complete,"
+           "nodes_to_first,nodes,branching,ms,difficulty_score,difficulty,total_solutions\n";
+    for (const auto& lv : levels) {
+        const LevelAnalysis& a = lv.result;
+        out << csv_field(lv.group) << ',' << csv_field(lv.id) << ',' << lv.width << ',' << lv.height << ','
+            << lv.piece_ids.size() << ',' << a.feasible << ',' << a.solvable << ',' << a.solution_count << ','
+            << a.complete << ',' << a.nodes_to_first << ',' << a.nodes << ',' << fixed(a.branching, 3) << ','
+            << fixed(a.seconds * 1000.0, 3) << ',' << fixed(a.difficulty_score(), 3) << ','
+            << a.difficulty() << ',' << (lv.total_known ? std::to_string(lv.total_solutions) : "") << '\n';
+    }
+}
+
+static void write_json(std::ostream& out, const std::vector<Level>& levels) {
+    out << "{\n  \"levels\": [";
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Level& lv = levels[i];
+        const LevelAnalysis& a = lv.result;
+        std::string ids;
+        for (size_t k = 0; k < lv.piece_ids.size(); ++k) ids += (k ? "," : "") + std::to_string(lv.piece_ids[k]);
+
+        out << (i ? ",\n" : "\n") << "    {\"group\": " << json_string(lv.group)
+            << ", \"id\": " << json_string(lv.id) << ", \"width\": " << lv.width
+            << ", \"height\": " << lv.height << ", \"pieceIds\": [" << ids << "]"
+            << ", \"feasible\": " << (a.feasible ? "true" : "false");
+        if (!a.feasible) out << ", \"reason\": " << json_string(a.reason);
+        out << ", \"solvable\": " << (a.solvable ? "true" : "false")
+            << ", \"solutionCount\": " << a.solution_count
+            << ", \"complete\": " << (a.complete ? "true" : "false")
+            << ", \"nodesToFirst\": " << a.nodes_to_first << ", \"nodes\": " << a.nodes
+            << ", \"branching\": " << fixed(a.branching, 3) << ", \"ms\": " << fixed(a.seconds * 1000.0, 3)
+            << ", \"difficultyScore\": " << fixed(a.difficulty_score(), 3)
+            << ", \"difficulty\": " << a.difficulty()
+            << ", \"totalSolutions\": " << (lv.total_known ? std::to_string(lv.total_solutions) : "null") << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+
+    const fs::path root = argv[1];
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::string format = "csv";
+    std::string output;
+    uint64_t limit = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--limit" && i + 1 < argc) {
+            limit = std::stoull(argv[++i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (format != "csv" && format != "json") {
+        usage();
+        return 2;
+    }
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(root, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec) {
+        std::cerr << "[ANALYZE] cannot read " << root.string() << ": " << ec.message() << "\n";
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Level> levels;
+    size_t failures = 0;
+    for (const auto& file : files) {
+        try {
+            LevelData ld = LevelLoader::load_level(file.string());
+            Level lv;
+            lv.group = file.parent_path().filename().string();
+            lv.id = file.stem().string();
+            lv.width = ld.width;
+            lv.height = ld.height;
+            for (const auto& p : ld.pieces) lv.piece_ids.push_back(p.get_id());
+            lv.analyzer = std::make_unique<LevelAnalyzer>(ld.width, ld.height, ld.pieces, limit);
+            lv.branches.resize(lv.analyzer->branch_count());
+            levels.push_back(std::move(lv));
+        } catch (const std::exception& e) {
+            std::cerr << "[ANALYZE] " << file.string() << " [FAIL] " << e.what() << "\n";
+            ++failures;
+        }
+    }
+
+    // Most pieces first: those levels are the slow ones, and starting them
+    // early leaves the small levels to fill the gaps at the end.
+    std::vector<size_t> order(levels.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return levels[a].piece_ids.size() > levels[b].piece_ids.size();
+    });
+    std::vector<Task> tasks;
+    for (size_t i : order) {
+        for (size_t b = 0; b < levels[i].branches.size(); ++b) tasks.push_back(Task{i, b});
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t t; (t = next.fetch_add(1)) < tasks.size();) {
+            Level& lv = levels[tasks[t].level];
+            lv.branches[tasks[t].branch] = lv.analyzer->run_branch(tasks[t].branch);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < std::min<size_t>(jobs, tasks.size()); ++t) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+
+    size_t solvable = 0;
+    double cpu_seconds = 0;
+    for (auto& lv : levels) {
+        lv.result = lv.analyzer->combine(lv.branches);
+        if (lv.result.solvable) ++solvable;
+        cpu_seconds += lv.result.seconds;
+
+        // The search stopped at --limit, but nodes and difficulty come from
+        // it and stay as they are; only the DP's count is cheap enough here.
+        lv.total_known = lv.result.complete;
+        lv.total_solutions = lv.result.solution_count;
+        if (lv.total_known) continue;
+        const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(lv.piece_ids);
+        if (FrontierCounter::supports(lv.width, lv.height, pieces)) {
+            const SolutionCount total = count_level_solutions(lv.width, lv.height, pieces, limit);
+            lv.total_known = total.complete;
+            lv.total_solutions = total.count;
+        }
+    }
+
+    std::ostringstream body;
+    if (format == "json") write_json(body, levels); else write_csv(body, levels);
+
+    if (output.empty()) {
+        std::cout << body.str();
+    } else {
+        std::ofstream out(output, std::ios::trunc);
+        out << body.str();
+        if (!out) {
+            std::cerr << "[ANALYZE] could not write " << output << "\n";
+            return 1;
+        }
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cerr << "[ANALYZE] levels=" << levels.size() << " solvable=" << solvable
+              << " failures=" << failures << " tasks=" << tasks.size() << " jobs=" << jobs
+              << " (" << ms << " ms wall, " << (long long)(cpu_seconds * 1000.0) << " ms search)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+// level_generator
+// --------------------------------
+// Sample random levels from PieceLibrary, keep the solvable ones and write
+// them as levels/<group>/levelsN.txt, numbered after the group's last level.
+//
+//   level_generator <levels_dir> <group> [--count N] [--pieces MIN-MAX] [--height H]
+//                   [--difficulty LO-HI] [--unique] [--jobs N] [--seed N]
+//                   [--max-candidates N] [--dry-run]
+//
+// --count           levels to write (default 10)
+// --pieces          distinct pieces per level (default 3-8)
+// --height          board height, the width follows from the area (default 5;
+//                   0 = any board with both sides >= 3)
+// --difficulty      LevelAnalysis::difficulty() band, e.g. 3-5 (default 1-5)
+// --unique          only levels with one solution up to board symmetry
+// --jobs            worker threads (default: hardware concurrency)
+// --seed            same seed, same levels, whatever the thread count
+// --max-candidates  give up after this many candidates (default 1000000)
+// --dry-run         print the levels instead of writing them
+//
+// Levels already under <levels_dir> (any group, either orientation) are not
+// generated again.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "../engine/level_generator.h"
+#include "../game/level_loader.h"
+
+namespace fs = std::filesystem;
+
+using InstanceKey = std::tuple<int, int, std::vector<int>>;
+
+static void usage() {
+    std::cerr << "usage: level_generator <levels_dir> <group> [--count N] [--pieces MIN-MAX] [--height H]\n"
+                 "                       [--difficulty LO-HI] [--unique] [--jobs N] [--seed N]\n"
+                 "                       [--max-candidates N] [--dry-run]\n";
+}
+
+// "3-8" or "5"
+static bool parse_range(const std::string& s, int& lo, int& hi) {
+    try {
+        const size_t dash = s.find('-');
+        lo = std::stoi(s.substr(0, dash));
+        hi = dash == std::string::npos ? lo : std::stoi(s.substr(dash + 1));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// the same level turned a quarter is not a new level
+static InstanceKey instance_key(int w, int h, std::vector<int> ids) {
+    std::sort(ids.begin(), ids.end());
+    return {std::min(w, h), std::max(w, h), ids};
+}
+
+// Highest N of <group>/levelsN.txt, 0 if none.
+static int last_level_number(const fs::path& group_dir) {
+    int last = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(group_dir, ec)) {
+        const std::string stem = entry.path().stem().string();
+        if (entry.path().extension() != ".txt" || stem.rfind("levels", 0) != 0) continue;
+        try {
+            last = std::max(last, std::stoi(stem.substr(6)));
+        } catch (const std::exception&) {
+        }
+    }
+    return last;
+}
+
+static std::string level_text(const LevelCandidate& c) {
+    std::string out = std::to_string(c.width) + " " + std::to_string(c.height) + "\n\n";
+    for (size_t i = 0; i < c.piece_ids.size(); ++i) {
+        if (i) out += ' ';
+        out += std::to_string(c.piece_ids[i]);
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    const fs::path root = argv[1];
+    const std::string group = argv[2];
+    GeneratorConstraints limits;
+    size_t count = 10;
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 1;
+    uint64_t max_candidates = 1000000;
+    bool dry_run = false;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--count" && i + 1 < argc) {
+            count = std::stoul(argv[++i]);
+        } else if (arg == "--pieces" && i + 1 < argc) {
+            ok = parse_range(argv[++i], limits.min_pieces, limits.max_pieces);
+        } else if (arg == "--height" && i + 1 < argc) {
+            limits.height = std::stoi(argv[++i]);
+        } else if (arg == "--difficulty" && i + 1 < argc) {
+            ok = parse_range(argv[++i], limits.min_difficulty, limits.max_difficulty);
+        } else if (arg == "--unique") {
+            limits.unique = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--max-candidates" && i + 1 < argc) {
+            max_candidates = std::stoull(argv[++i]);
+        } else if (arg == "--dry-run") {
+            dry_run = true;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage();
+            return 2;
+        }
+    }
+
+    std::unique_ptr<LevelGenerator> generator;
+    try {
+        generator = std::make_unique<LevelGenerator>(limits, seed);
+    } catch (const std::exception& e) {
+        std::cerr << "[GEN] " << e.what() << "\n";
+        return 2;
+    }
+
+    // existing catalogue, to skip instances it already has
+    std::set<InstanceKey> known;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(root, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".txt") continue;
+        try {
+            LevelData ld = LevelLoader::load_level(entry.path().string());
+            std::vector<int> ids;
+            for (const auto& p : ld.pieces) ids.push_back(p.get_id());
+            known.insert(instance_key(ld.width, ld.height, ids));
+        } catch (const std::exception& e) {
+            std::cerr << "[GEN] skipping " << entry.path().string() << ": " << e.what() << "\n";
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::atomic<uint64_t> next{0};
+    std::atomic<uint64_t> candidates{0};
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> verdicts[6] = {};
+    std::atomic<uint64_t> repeats{0};
+    std::atomic<uint64_t> existing{0};
+
+    // Instances seen so far with the lowest index that produced them, and the
+    // accepted ones. Pieces are sampled from only 12, so most candidates
+    // repeat an earlier instance and are dropped here before any search.
+    std::mutex mutex;
+    std::map<InstanceKey, uint64_t> first_index;
+    std::map<InstanceKey, LevelCandidate> accepted;
+
+    // Indices are claimed in order, so every index below the last one claimed
+    // is looked at; with the lowest index kept per instance, the first
+    // `count` levels by index are the same for any --jobs.
+    auto worker = [&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            const uint64_t index = next.fetch_add(1);
+            if (index >= max_candidates) break;
+            candidates.fetch_add(1, std::memory_order_relaxed);
+
+            LevelCandidate c = generator->sample(index);
+            const InstanceKey key = instance_key(c.width, c.height, c.piece_ids);
+            if (known.count(key)) {
+                existing.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto [it, inserted] = first_index.emplace(key, index);
+                if (!inserted) {
+                    it->second = std::min(it->second, index);
+                    auto a = accepted.find(key);
+                    if (a != accepted.end()) a->second.index = it->second;
+                    repeats.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+            }
+
+            const CandidateVerdict v = generator->check(c);
+            verdicts[(int)v].fetch_add(1, std::memory_order_relaxed);
+            if (v != CandidateVerdict::Accepted) continue;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            c.index = first_index[key];
+            accepted.emplace(key, c);
+            if (accepted.size() >= count) done = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < jobs; ++t) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t searched = 0;
+    for (const auto& v : verdicts) searched += v.load();
+
+    std::vector<LevelCandidate> chosen;
+    for (const auto& [key, c] : accepted) chosen.push_back(c);
+    std::sort(chosen.begin(), chosen.end(),
+              [](const LevelCandidate& a, const LevelCandidate& b) { return a.index < b.index; });
+    if (chosen.size() > count) chosen.resize(count);
+
+    const fs::path group_dir = root / group;
+    int number = last_level_number(group_dir);
+    if (!dry_run && !chosen.empty()) fs::create_directories(group_dir);
+
+    for (const auto& c : chosen) {
+        const fs::path file = group_dir / ("levels" + std::to_string(++number) + ".txt");
+        if (!dry_run) {
+            std::ofstream out(file, std::ios::trunc);
+            out << level_text(c);
+            if (!out) {
+                std::cerr << "[GEN] could not write " << file.string() << "\n";
+                return 1;
+            }
+        }
+        std::cout << file.string() << ": " << c.width << "x" << c.height << " pieces=";
+        for (size_t i = 0; i < c.piece_ids.size(); ++i) std::cout << (i ? "," : "") << c.piece_ids[i];
+        if (c.solutions > 0) std::cout << " solutions=" << c.solutions;
+        if (c.difficulty > 0) std::cout << " difficulty=" << c.difficulty;
+        std::cout << "\n";
+    }
+
+    const uint64_t checked = candidates.load();
+    std::cerr << "[GEN] checked=" << checked << " searched=" << searched << " accepted=" << chosen.size()
+              << "/" << count << " existing=" << existing.load() << " repeat=" << repeats.load();
+    for (int v = 1; v < 6; ++v) {
+        std::cerr << " " << to_string((CandidateVerdict)v) << "=" << verdicts[v].load();
+    }
+    std::cerr << " jobs=" << jobs << " (" << (long long)(seconds * 1000.0) << " ms, "
+              << (long long)(seconds > 0 ? checked / seconds : 0) << " candidates/s)\n";
+    return chosen.size() == count ? 0 : 1;
+}
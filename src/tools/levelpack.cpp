@@ -0,0 +1,101 @@
+// levelpack
+// --------------------------------
+// Compile levels/<group>/*.txt into one binary pack the server can mmap.
+//
+//   levelpack <levels_dir> <output.pack> [--solutions] [--count-limit N]
+//
+// --solutions    also store the first solution path and the solution count
+// --count-limit  stop counting a level after N solutions (0 = count all);
+//                levels the frontier DP counts get their exact count anyway
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../engine/board.h"
+#include "../engine/kernel_dispatch.h"
+#include "../engine/solution_count.h"
+#include "../engine/solver.h"
+#include "../game/level_loader.h"
+#include "../web/level_pack.h"
+
+namespace fs = std::filesystem;
+
+static void usage() {
+    std::cerr << "usage: levelpack <levels_dir> <output.pack> [--solutions] [--count-limit N]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    const fs::path root = argv[1];
+    const std::string output = argv[2];
+    bool with_solutions = false;
+    uint64_t count_limit = 0;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--solutions") {
+            with_solutions = true;
+        } else if (arg == "--count-limit" && i + 1 < argc) {
+            count_limit = std::stoull(argv[++i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    int failures = 0;
+    std::vector<levelpack::SourceGroup> groups;
+
+    auto solve = [&](levelpack::SourceLevel& level, const LevelData& ld) {
+        if (!with_solutions) return;
+        bool solved = false;
+        if (const SolverKernel* kernel = find_kernel(ld.width, ld.height)) {
+            solved = kernel->solve(ld.pieces, level.path);
+        } else {
+            Board board(ld.width, ld.height);
+            Solver solver(board, ld.pieces);
+            solved = solver.solve();
+            if (solved) level.path = solver.get_placements_path();
+        }
+        if (solved) level.solution_count = count_level_solutions(ld.width, ld.height, ld.pieces, count_limit).count;
+        level.status = solved ? levelpack::kStatusSolved : levelpack::kStatusUnsolvable;
+    };
+    auto failed = [&](const std::string& file, const std::exception& e) {
+        std::cerr << "[PACK] " << file << " [LOAD FAIL] " << e.what() << "\n";
+        ++failures;
+    };
+
+    try {
+        groups = levelpack::read_level_dir(root.string(), failed, solve);
+    } catch (const std::exception& e) {
+        std::cerr << "[PACK] " << e.what() << "\n";
+        return 1;
+    }
+
+    try {
+        levelpack::write_pack(output, groups, with_solutions);
+    } catch (const std::exception& e) {
+        std::cerr << "[PACK] " << e.what() << "\n";
+        return 1;
+    }
+
+    size_t levels = 0;
+    for (const auto& g : groups) levels += g.levels.size();
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[PACK] wrote " << output << ": groups=" << groups.size()
+              << " levels=" << levels << " failures=" << failures
+              << " solutions=" << (with_solutions ? "yes" : "no")
+              << " (" << ms << " ms)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// solutiondb
+// --------------------------------
+// Enumerate every solution of every level under levels/<group>/*.txt and
+// write them to a solution database the server can answer hints from.
+//
+//   solutiondb <levels_dir> <output.db> [--jobs N] [--limit N]
+//
+// --jobs   worker threads (default: hardware concurrency)
+// --limit  keep at most N solutions per level (0 = all); a cut level is
+//          marked incomplete, so it cannot prove dead ends
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../game/level_loader.h"
+#include "../web/solution_db.h"
+
+namespace fs = std::filesystem;
+
+static void usage() {
+    std::cerr << "usage: solutiondb <levels_dir> <output.db> [--jobs N] [--limit N]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    const fs::path root = argv[1];
+    const std::string output = argv[2];
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t limit = 0;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--limit" && i + 1 < argc) {
+            limit = std::stoull(argv[++i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(root, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec) {
+        std::cerr << "[SOLDB] cannot read " << root.string() << ": " << ec.message() << "\n";
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<solutiondb::SourceLevel> levels(files.size());
+    std::vector<char> ok(files.size(), 0);
+    std::atomic<size_t> next{0};
+    std::mutex log_mutex;
+
+    // levels differ by orders of magnitude in cost, so hand them out one at a time
+    auto worker = [&]() {
+        for (size_t i; (i = next.fetch_add(1)) < files.size();) {
+            try {
+                LevelData ld = LevelLoader::load_level(files[i].string());
+                levels[i] = solutiondb::enumerate_level(ld.width, ld.height, ld.pieces, limit);
+                ok[i] = 1;
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(log_mutex);
+                std::cerr << "[SOLDB] " << files[i].string() << " [FAIL] " << e.what() << "\n";
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < std::min<size_t>(jobs, files.size()); ++t) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+
+    std::vector<solutiondb::SourceLevel> good;
+    uint64_t solutions = 0;
+    size_t incomplete = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!ok[i]) continue;
+        solutions += levels[i].solution_count;
+        if (!levels[i].complete) ++incomplete;
+        good.push_back(std::move(levels[i]));
+    }
+
+    try {
+        solutiondb::write_db(output, good);
+    } catch (const std::exception& e) {
+        std::cerr << "[SOLDB] " << e.what() << "\n";
+        return 1;
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    const size_t failures = files.size() - good.size();
+
+    std::cout << "[SOLDB] wrote " << output << ": levels=" << good.size()
+              << " solutions=" << solutions << " incomplete=" << incomplete
+              << " failures=" << failures << " jobs=" << jobs
+              << " (" << ms << " ms, " << fs::file_size(output) << " bytes)\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+#include "hint_service.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "../engine/iterative_solver.h"
+#include "../engine/piece_library.h"
+#include "../engine/placement_table.h"
+#include "level_pack.h"
+
+const char* to_string(HintStatus status) {
+    switch (status) {
+        case HintStatus::Next: return "next";
+        case HintStatus::DeadEnd: return "dead_end";
+        case HintStatus::Complete: return "complete";
+        case HintStatus::Unknown: return "unknown";
+        case HintStatus::Invalid: return "invalid";
+    }
+    return "invalid";
+}
+
+const char* to_string(HintSource source) {
+    switch (source) {
+        case HintSource::Database: return "db";
+        case HintSource::Cache: return "cache";
+        case HintSource::Search: return "search";
+    }
+    return "search";
+}
+
+namespace {
+
+class MaskedPlacement {
+public:
+    uint64_t mask = 0;
+    Placement placement{-1, -1, Cell{0, 0}};
+};
+
+const Piece* find_piece(const std::vector<Piece>& pieces, int id) {
+    for (const auto& p : pieces) {
+        if (p.get_id() == id) return &p;
+    }
+    return nullptr;
+}
+
+uint64_t placement_mask(int width, const std::vector<Cell>& variant, const Cell& offset) {
+    uint64_t mask = 0;
+    for (const auto& c : variant) {
+        mask |= 1ull << ((c.y + offset.y) * width + (c.x + offset.x));
+    }
+    return mask;
+}
+
+// Match the player's cells against the piece's variants. Returns false with
+// the reason in `error` when they are not a placement of that piece.
+bool to_placement(int width, int height, const Piece& piece, const HintPiece& hp,
+                  MaskedPlacement& out, std::string& error) {
+    const std::string name = "Placed piece " + std::to_string(hp.pieceId);
+    if (hp.cells.size() != piece.get_shape().size()) {
+        error = name + " has " + std::to_string(hp.cells.size()) + " cells, expected " +
+                std::to_string(piece.get_shape().size()) + ".";
+        return false;
+    }
+
+    std::vector<Cell> cells;
+    cells.reserve(hp.cells.size());
+    for (const auto& c : hp.cells) {
+        if (c.x < 0 || c.x >= width || c.y < 0 || c.y >= height) {
+            error = name + " is outside the board.";
+            return false;
+        }
+        cells.push_back(Cell{c.x, c.y});
+    }
+
+    const std::vector<Cell> shape = Piece::normalize(cells);
+    const auto& variants = piece.get_variants();
+    for (size_t v = 0; v < variants.size(); ++v) {
+        if (variants[v] != shape) continue;
+
+        // normalize() moved the cells to the origin: the offset is the minimum
+        Cell offset = cells[0];
+        for (const auto& c : cells) {
+            offset.x = std::min(offset.x, c.x);
+            offset.y = std::min(offset.y, c.y);
+        }
+        out.placement = Placement(piece.get_id(), (int)v, offset);
+        out.mask = placement_mask(width, variants[v], offset);
+        return true;
+    }
+    error = name + " does not match any orientation of the piece.";
+    return false;
+}
+
+PlacementDTO to_dto(const std::vector<Piece>& pieces, const Placement& p) {
+    return make_solve_result(pieces, {p}).placements.front();
+}
+
+}  // namespace
+
+// Every solution of one level (up to a limit), N placements per solution.
+class HintService::SolutionSet {
+public:
+    int width = 0;
+    int height = 0;
+    std::vector<int> sorted_ids;        // to reject instance_key collisions
+    size_t stride = 0;                  // placements per solution
+    std::vector<MaskedPlacement> placements;
+    bool complete = false;              // every solution is in the set
+
+    size_t count() const { return stride ? placements.size() / stride : 0; }
+};
+
+HintService::HintService(size_t levels, size_t solutions, uint64_t budget, uint64_t enumeration)
+    : max_levels(levels), max_solutions(solutions), node_budget(budget), enumeration_budget(enumeration) {}
+
+void HintService::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.clear();
+    lru.clear();
+    ++generation;
+}
+
+size_t HintService::cached_levels() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.size();
+}
+
+bool HintService::is_cached(int w, int h, const std::vector<int>& piece_ids) const {
+    std::vector<int> ids(piece_ids);
+    const uint64_t key = levelpack::instance_key(w, h, ids);
+    std::sort(ids.begin(), ids.end());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    return it != cache.end() && it->second.set->width == w && it->second.set->height == h &&
+           it->second.set->sorted_ids == ids;
+}
+
+std::shared_ptr<const HintService::SolutionSet>
+HintService::solution_set(int w, int h, const std::vector<Piece>& pieces) {
+    std::vector<int> ids;
+    for (const auto& p : pieces) ids.push_back(p.get_id());
+    const uint64_t key = levelpack::instance_key(w, h, ids);
+    std::sort(ids.begin(), ids.end());
+
+    uint64_t gen;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end() && it->second.set->width == w && it->second.set->height == h &&
+            it->second.set->sorted_ids == ids) {
+            lru.splice(lru.begin(), lru, it->second.recency);
+            return it->second.set;
+        }
+        gen = generation;
+    }
+
+    // enumerate outside the lock; concurrent misses on one level may build it twice
+    auto set = std::make_shared<SolutionSet>();
+    set->width = w;
+    set->height = h;
+    set->sorted_ids = ids;
+    set->stride = pieces.size();
+
+    IterativeSolver solver(w, h, pieces);
+    size_t found = 0;
+    SearchStatus status = SearchStatus::Paused;
+    while (solver.get_stats().nodes < enumeration_budget) {
+        status = solver.next(enumeration_budget - solver.get_stats().nodes);
+        if (status != SearchStatus::Found) break;
+        for (const auto& p : solver.get_placements_path()) {
+            const Piece* piece = find_piece(pieces, p.get_piece_id());
+            set->placements.push_back(MaskedPlacement{
+                placement_mask(w, piece->get_variants()[p.get_variant_index()], p.get_offset()), p});
+        }
+        if (++found >= max_solutions) break;
+    }
+    set->complete = status == SearchStatus::Exhausted;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (generation == gen) {
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            // built twice concurrently, or an instance_key collision: replace it
+            lru.erase(it->second.recency);
+            cache.erase(it);
+        }
+        while (!cache.empty() && cache.size() >= max_levels) {
+            cache.erase(lru.back());
+            lru.pop_back();
+        }
+        lru.push_front(key);
+        cache[key] = CacheEntry{set, lru.begin()};
+    }
+    return set;
+}
+
+HintResult HintService::hint(const HintRequest& req) {
+    HintResult out;
+
+    SolveRequest sr;
+    sr.width = req.width;
+    sr.height = req.height;
+    sr.piece_ids = req.piece_ids;
+
+    std::vector<Piece> pieces;
+    SolveResult check;
+    if (!prepare_pieces(sr, pieces, check)) {
+        out.error_message = check.error_message;
+        return out;
+    }
+    if (!PlacementTable::supports(req.width, req.height)) {
+        out.error_message = "Hints need a board of at most " + std::to_string(PlacementTable::kMaxCells) + " cells.";
+        return out;
+    }
+
+    // seed the board with the player's pieces; each piece copy is used once
+    std::vector<const Piece*> remaining;
+    for (const auto& p : pieces) remaining.push_back(&p);
+
+    std::vector<MaskedPlacement> placed;
+    uint64_t occupied = 0;
+    for (const auto& hp : req.placed) {
+        auto it = std::find_if(remaining.begin(), remaining.end(),
+                               [&](const Piece* p) { return p->get_id() == hp.pieceId; });
+        if (it == remaining.end()) {
+            out.error_message = "Piece " + std::to_string(hp.pieceId) + " is not left in this level.";
+            return out;
+        }
+
+        MaskedPlacement mp;
+        if (!to_placement(req.width, req.height, **it, hp, mp, out.error_message)) {
+            return out;
+        }
+        if (mp.mask & occupied) {
+            out.error_message = "Placed pieces overlap.";
+            return out;
+        }
+        occupied |= mp.mask;
+        placed.push_back(mp);
+        remaining.erase(it);
+    }
+
+    const int cells = req.width * req.height;
+    const uint64_t full = cells == 64 ? ~0ull : (1ull << cells) - 1;
+    if (occupied == full) {
+        out.status = HintStatus::Complete;
+        return out;
+    }
+    const uint64_t first_empty = 1ull << PlacementTable::first_empty(occupied);
+
+    // 1) the offline solution database
+    std::vector<int> ids;
+    for (const auto& p : pieces) ids.push_back(p.get_id());
+    const solutiondb::DbLevel* db_level = solution_db ? solution_db->find_level(req.width, req.height, ids) : nullptr;
+    if (db_level && db_level->piece_count == pieces.size()) {
+        try {
+            std::vector<PlacedPiece> fixed;
+            for (const auto& mp : placed) fixed.push_back(PlacedPiece{mp.placement.get_piece_id(), mp.mask});
+
+            const auto db_pieces = PieceLibrary::get_piece_by_id(solution_db->piece_ids(*db_level));
+            const PlacementTable table(req.width, req.height, db_pieces);
+            const auto hits = solution_db->consistent(*db_level, table, fixed, 1);
+            if (!hits.empty()) {
+                for (const auto& p : solution_db->decode(*db_level, table, hits.front())) {
+                    const Piece* piece = find_piece(pieces, p.get_piece_id());
+                    if (placement_mask(req.width, piece->get_variants()[p.get_variant_index()], p.get_offset()) & first_empty) {
+                        out.status = HintStatus::Next;
+                        out.next = to_dto(pieces, p);
+                        out.source = HintSource::Database;
+                        return out;
+                    }
+                }
+            }
+            if (db_level->flags & solutiondb::kLevelComplete) {
+                out.status = HintStatus::DeadEnd;
+                out.source = HintSource::Database;
+                return out;
+            }
+        } catch (const std::runtime_error& e) {
+            // a record that does not replay: answer from the solution set instead
+            std::cerr << "[SOLDB] " << e.what() << " (" << req.width << "x" << req.height << ")\n";
+        }
+    }
+
+    // 2) the level's solution set
+    auto set = solution_set(req.width, req.height, pieces);
+    for (size_t s = 0; s < set->count(); ++s) {
+        const MaskedPlacement* begin = set->placements.data() + s * set->stride;
+        const MaskedPlacement* end = begin + set->stride;
+
+        const bool contains_all = std::all_of(placed.begin(), placed.end(), [&](const MaskedPlacement& mp) {
+            return std::any_of(begin, end, [&](const MaskedPlacement& sp) {
+                return sp.mask == mp.mask && sp.placement.get_piece_id() == mp.placement.get_piece_id();
+            });
+        });
+        if (!contains_all) continue;
+
+        for (const MaskedPlacement* sp = begin; sp != end; ++sp) {
+            if (sp->mask & first_empty) {
+                out.status = HintStatus::Next;
+                out.next = to_dto(pieces, sp->placement);
+                out.source = HintSource::Cache;
+                return out;
+            }
+        }
+    }
+    if (set->complete) {
+        out.status = HintStatus::DeadEnd;
+        out.source = HintSource::Cache;
+        return out;
+    }
+
+    // 3) the set was truncated: bounded search of the remaining pieces
+    std::vector<Piece> rest;
+    for (const Piece* p : remaining) rest.push_back(*p);
+
+    IterativeSolver solver(req.width, req.height, rest);
+    solver.reset(occupied);
+    const SearchStatus status = solver.next(node_budget);
+    out.nodes = solver.get_stats().nodes;
+
+    if (status == SearchStatus::Found) {
+        out.status = HintStatus::Next;
+        out.next = to_dto(pieces, solver.get_placements_path().front());
+    } else {
+        out.status = status == SearchStatus::Exhausted ? HintStatus::DeadEnd : HintStatus::Unknown;
+    }
+    return out;
+}
@@ -0,0 +1,110 @@
+#ifndef HINT_SERVICE_H
+#define HINT_SERVICE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "solution_db.h"
+#include "solve_api.h"
+
+// A piece the player already put on the board (absolute cells, any order).
+class HintPiece {
+public:
+    int pieceId = -1;
+    std::vector<CellDTO> cells;
+};
+
+class HintRequest {
+public:
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;         // the level, as in SolveRequest
+    std::vector<HintPiece> placed;
+};
+
+enum class HintStatus {
+    Next,       // `next` extends the board towards a solution
+    DeadEnd,    // no solution contains the placed pieces
+    Complete,   // the board is already solved
+    Unknown,    // the bounded search gave up before deciding
+    Invalid,    // bad request, see error_message
+};
+
+enum class HintSource {
+    Database,   // offline solution database (solutiondb tool)
+    Cache,      // the level's cached solution set
+    Search,     // bounded search from the partial board
+};
+
+class HintResult {
+public:
+    HintStatus status = HintStatus::Invalid;
+    PlacementDTO next;                  // set when status == Next
+    HintSource source = HintSource::Search;
+    uint64_t nodes = 0;                 // search nodes spent, 0 unless searched
+    std::string error_message;
+};
+
+const char* to_string(HintStatus status);
+const char* to_string(HintSource source);
+
+// Answers "what goes next?" for a partially filled board.
+// --------------------------------
+// Levels in the solution database (set_solution_db) are answered by a binary
+// search walk over their stored solutions, with no solving at all. Otherwise
+// the first hint for a level enumerates its solutions once (boards of at most
+// 64 cells, up to max_solutions of them, within enumeration_budget nodes) and
+// keeps them as placement masks.
+// A hint is then a scan for the first stored solution that contains every
+// placed piece; the missing piece covering the first empty cell is returned.
+//
+// When the set was cut at max_solutions or by the enumeration budget (large
+// custom boards can take minutes to enumerate), a miss is not proof of a dead end,
+// so the remaining pieces are searched from the partial board for at most
+// node_budget nodes.
+//
+// At most max_levels sets are kept, dropping the least recently used one.
+// clear() drops every cached set; the server calls it when the level
+// catalogue reloads.
+class HintService {
+public:
+    explicit HintService(size_t max_levels = 256, size_t max_solutions = 50000,
+                         uint64_t node_budget = 2000000, uint64_t enumeration_budget = 20000000);
+
+    HintResult hint(const HintRequest& req);
+
+    // Optional; must outlive the service. Set it before serving requests.
+    void set_solution_db(const SolutionDb* db) { solution_db = db; }
+
+    void clear();
+    size_t cached_levels() const;
+    bool is_cached(int width, int height, const std::vector<int>& piece_ids) const;
+
+private:
+    class SolutionSet;
+
+    std::shared_ptr<const SolutionSet> solution_set(int w, int h, const std::vector<Piece>& pieces);
+
+    size_t max_levels;
+    size_t max_solutions;
+    uint64_t node_budget;
+    uint64_t enumeration_budget;
+    const SolutionDb* solution_db = nullptr;
+
+    mutable std::mutex mutex;
+    uint64_t generation = 0;            // bumped by clear()
+    // least recently used level first out, once max_levels are cached
+    struct CacheEntry {
+        std::shared_ptr<const SolutionSet> set;
+        std::list<uint64_t>::iterator recency;     // into lru
+    };
+    std::unordered_map<uint64_t, CacheEntry> cache;
+    std::list<uint64_t> lru;            // keys, most recently used first
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "json_body.h"
+
+#include <algorithm>
+
+using json = nlohmann::json;
+
+EncodedBody encode_body(const json& body, const std::string& accept) {
+    const size_t cbor = accept.find("application/cbor");
+    const size_t msgpack = std::min(accept.find("application/msgpack"), accept.find("application/x-msgpack"));
+    const size_t text = accept.find("application/json");
+
+    EncodedBody out;
+    if (cbor != std::string::npos && cbor < std::min(msgpack, text)) {
+        json::to_cbor(body, out.content);
+        out.content_type = "application/cbor";
+    } else if (msgpack != std::string::npos && msgpack < text) {
+        json::to_msgpack(body, out.content);
+        out.content_type = "application/msgpack";
+    } else {
+        out.content = body.dump();
+        out.content_type = "application/json; charset=utf-8";
+    }
+    return out;
+}
+
+json placements_json(const std::vector<PlacementDTO>& dtos, int index_width) {
+    json placements = json::array();
+    for (const auto& p : dtos) {
+        json pj;
+        pj["pieceId"] = p.pieceId;
+        pj["variantIndex"] = p.variantIndex; // debug 用
+
+        json cells = json::array();
+        for (const auto& c : p.cells) {
+            if (index_width > 0) {
+                cells.push_back(c.y * index_width + c.x);
+            } else {
+                cells.push_back({{"x", c.x}, {"y", c.y}});
+            }
+        }
+        pj["cells"] = std::move(cells);
+
+        placements.push_back(std::move(pj));
+    }
+    return placements;
+}
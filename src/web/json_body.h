@@ -0,0 +1,26 @@
+#ifndef JSON_BODY_H
+#define JSON_BODY_H
+
+#include <string>
+#include <vector>
+
+#include "../../external/json.hpp"
+#include "solve_api.h"
+
+class EncodedBody {
+public:
+    std::string content;
+    std::string content_type;
+};
+
+// A JSON value in the encoding the client accepts.
+// --------------------------------
+// CBOR, MessagePack, or (default) JSON without indentation, like every other
+// body the server sends. The first of these types named in `accept` (the
+// Accept header) wins; quality values are not weighed.
+EncodedBody encode_body(const nlohmann::json& body, const std::string& accept);
+
+// index_width > 0: cells as flat board indices y * index_width + x
+nlohmann::json placements_json(const std::vector<PlacementDTO>& dtos, int index_width = 0);
+
+#endif
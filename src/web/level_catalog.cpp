@@ -0,0 +1,186 @@
+#include "level_catalog.h"
+#include "../game/level_loader.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+const LevelInfo* LevelCatalog::find_level(const std::string& group_id, const std::string& level_id) const {
+    for (const auto& g : groups) {
+        if (g.id != group_id) continue;
+        for (const auto& lv : g.levels) {
+            if (lv.id == level_id) return &lv;
+        }
+    }
+    return nullptr;
+}
+
+LevelInfo load_level_info(const std::string& path) {
+    LevelData ld = LevelLoader::load_level(path);
+
+    LevelInfo li;
+    li.id = fs::path(path).stem().string();      // level1
+    li.name = li.id;
+    li.width = ld.width;
+    li.height = ld.height;
+
+    // pieceIds：從 ld.pieces 抽 id，並去重 + 排序
+    std::vector<int> ids;
+    ids.reserve(ld.pieces.size());
+    for (const auto& pc : ld.pieces) {
+        ids.push_back(pc.get_id());
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    li.pieceIds = std::move(ids);
+    return li;
+}
+
+static bool is_level_file(const fs::path& p) {
+    std::error_code ec;
+    return fs::is_regular_file(p, ec) && p.extension() == ".txt";
+}
+
+// Parse one file into `files`; a failed parse removes the stale entry.
+static void parse_into(std::map<std::string, LevelFileEntry>& files, const fs::path& file) {
+    const std::string key = file.string();
+    try {
+        LevelFileEntry entry;
+        entry.group_id = file.parent_path().filename().string();
+        entry.info = load_level_info(key);
+        std::cerr << "  - " << file.filename().string()
+                  << " (" << entry.info.width << "x" << entry.info.height
+                  << ", pieces=" << entry.info.pieceIds.size() << ")\n";
+        files[key] = std::move(entry);
+    } catch (const std::exception& e) {
+        std::cerr << "  - " << file.filename().string()
+                  << " [LOAD FAIL] " << e.what() << "\n";
+        files.erase(key);
+    }
+}
+
+static void scan_group(std::map<std::string, LevelFileEntry>& files, const fs::path& group_path) {
+    std::error_code ec;
+    std::cerr << "[GROUP] " << group_path.filename().string() << "\n";
+    for (const auto& fileEntry : fs::directory_iterator(group_path, ec)) {
+        if (!is_level_file(fileEntry.path())) continue;
+        parse_into(files, fileEntry.path());
+    }
+    if (ec) {
+        std::cerr << "[LEVEL] iterator error: " << ec.message() << "\n";
+    }
+}
+
+LevelCatalogStore::LevelCatalogStore(std::string r)
+    : root(std::move(r)), current(std::make_shared<const LevelCatalog>()) {}
+
+std::shared_ptr<const LevelCatalog> LevelCatalogStore::snapshot() const {
+    return current.load(std::memory_order_acquire);
+}
+
+void LevelCatalogStore::load_all() {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
+    std::error_code ec;
+    std::cerr << "[LEVEL] root=" << root << "\n";
+    std::cerr << "[LEVEL] is_dir=" << (fs::is_directory(root, ec) ? "yes" : "no") << "\n";
+
+    std::map<std::string, LevelFileEntry> files;
+    std::set<std::string> group_dirs;
+    for (const auto& groupEntry : fs::directory_iterator(root, ec)) {
+        if (!groupEntry.is_directory()) continue;
+        group_dirs.insert(groupEntry.path().filename().string());
+        scan_group(files, groupEntry.path());
+    }
+    if (ec) {
+        std::cerr << "[LEVEL] iterator error: " << ec.message() << "\n";
+    }
+
+    publish(std::move(files), std::move(group_dirs));
+}
+
+void LevelCatalogStore::reload_paths(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+
+    // copy-on-write: untouched entries are reused as-is
+    std::map<std::string, LevelFileEntry> files = snapshot()->files;
+    std::set<std::string> group_dirs = snapshot()->group_dirs;
+
+    for (const auto& raw : paths) {
+        const fs::path p(raw);
+        std::error_code ec;
+
+        if (fs::is_directory(p, ec)) {
+            // a (re)created group folder: drop what we had and rescan it
+            const std::string prefix = p.string() + "/";
+            std::erase_if(files, [&](const auto& kv) { return kv.first.starts_with(prefix); });
+            if (is_group_dir(p)) group_dirs.insert(p.filename().string());
+            scan_group(files, p);
+        } else if (is_level_file(p)) {
+            parse_into(files, p);
+        } else {
+            // removed file or folder
+            const std::string prefix = p.string() + "/";
+            std::erase_if(files, [&](const auto& kv) {
+                return kv.first == p.string() || kv.first.starts_with(prefix);
+            });
+            if (is_group_dir(p)) group_dirs.erase(p.filename().string());
+        }
+    }
+
+    publish(std::move(files), std::move(group_dirs));
+}
+
+// A direct child of root, i.e. a group folder (existing or removed).
+bool LevelCatalogStore::is_group_dir(const fs::path& p) const {
+    fs::path r = fs::path(root).lexically_normal();
+    if (!r.has_filename()) r = r.parent_path();     // "levels/"
+    return p.parent_path().lexically_normal() == r;
+}
+
+void LevelCatalogStore::on_reload(std::function<void(uint64_t)> callback) {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    reload_callbacks.push_back(std::move(callback));
+}
+
+// Must be called with writer_mutex held.
+void LevelCatalogStore::publish(std::map<std::string, LevelFileEntry> files, std::set<std::string> group_dirs) {
+    auto next = std::make_shared<LevelCatalog>();
+    next->generation = snapshot()->generation + 1;
+
+    // every folder is a group, listed even when none of its files loaded
+    std::map<std::string, LevelGroup> by_group;
+    for (const auto& id : group_dirs) {
+        LevelGroup& g = by_group[id];
+        g.id = id;
+        g.name = id;
+    }
+    for (const auto& [path, entry] : files) {
+        LevelGroup& g = by_group[entry.group_id];
+        g.id = entry.group_id;
+        g.name = entry.group_id;
+        g.levels.push_back(entry.info);
+    }
+
+    // std::map already keeps groups sorted by name
+    for (auto& [id, g] : by_group) {
+        std::sort(g.levels.begin(), g.levels.end(),
+                  [](const LevelInfo& a, const LevelInfo& b) { return a.id < b.id; });
+        next->groups.push_back(std::move(g));
+    }
+    next->files = std::move(files);
+    next->group_dirs = std::move(group_dirs);
+
+    std::cerr << "[INFO] catalogue generation=" << next->generation
+              << " groups=" << next->groups.size() << "\n";
+
+    const uint64_t generation = next->generation;
+    current.store(std::move(next), std::memory_order_release);
+
+    for (const auto& cb : reload_callbacks) {
+        cb(generation);
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef LEVEL_CATALOG_H
+#define LEVEL_CATALOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../game/level_data.h"
+
+struct LevelGroup {
+    std::string id;      // group folder name
+    std::string name;    // 先同 id
+    std::vector<LevelInfo> levels;
+};
+
+// One parsed level file, remembered so a reload only reparses changed files.
+struct LevelFileEntry {
+    std::string group_id;
+    LevelInfo info;
+};
+
+// Immutable catalogue snapshot. Readers hold a shared_ptr to it, so it never
+// changes under them; a reload builds a new one and swaps it in.
+class LevelCatalog {
+public:
+    uint64_t generation = 0;
+    std::vector<LevelGroup> groups;              // sorted by name, levels sorted by id
+    std::map<std::string, LevelFileEntry> files; // keyed by file path
+    std::set<std::string> group_dirs;            // every group folder, empty ones too
+
+    const LevelInfo* find_level(const std::string& group_id, const std::string& level_id) const;
+};
+
+class LevelCatalogStore {
+public:
+    explicit LevelCatalogStore(std::string root);
+
+    const std::string& get_root() const { return root; }
+
+    // Lock-free for readers: an atomic load of the current snapshot.
+    std::shared_ptr<const LevelCatalog> snapshot() const;
+
+    // Full scan of root/<group>/*.txt.
+    void load_all();
+
+    // Reparse only the given paths (files or group folders). Paths that no
+    // longer exist are dropped from the catalogue.
+    void reload_paths(const std::vector<std::string>& paths);
+
+    // Called with the new generation after every publish; caches keyed on
+    // levels register here to drop stale entries.
+    void on_reload(std::function<void(uint64_t)> callback);
+
+private:
+    void publish(std::map<std::string, LevelFileEntry> files, std::set<std::string> group_dirs);
+    bool is_group_dir(const std::filesystem::path& p) const;
+
+    std::string root;
+    std::atomic<std::shared_ptr<const LevelCatalog>> current;
+
+    std::mutex writer_mutex;    // serializes writers only
+    std::vector<std::function<void(uint64_t)>> reload_callbacks;
+};
+
+// Parse one level file into the metadata served by /groups.
+LevelInfo load_level_info(const std::string& path);
+
+#endif
@@ -0,0 +1,83 @@
+#include "level_difficulty.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+// One CSV record; fields may be quoted, with "" for a quote inside.
+static std::vector<std::string> split_csv(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+std::unique_ptr<LevelDifficultyTable> LevelDifficultyTable::load_csv(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in) {
+        throw std::runtime_error("Could not open level analysis: " + filename);
+    }
+
+    std::string line;
+    if (!std::getline(in, line)) {
+        throw std::runtime_error("Empty level analysis: " + filename);
+    }
+
+    // columns by name, so the tool can add more without breaking this
+    const auto header = split_csv(line);
+    auto column = [&](const std::string& name) {
+        for (size_t i = 0; i < header.size(); ++i) {
+            if (header[i] == name) return i;
+        }
+        throw std::runtime_error("Level analysis " + filename + " has no '" + name + "' column");
+    };
+    const size_t group = column("group");
+    const size_t level = column("level");
+    const size_t solvable = column("solvable");
+    const size_t solutions = column("solutions");
+    const size_t score = column("difficulty_score");
+    const size_t difficulty = column("difficulty");
+
+    std::unique_ptr<LevelDifficultyTable> table(new LevelDifficultyTable());
+    for (size_t row = 2; std::getline(in, line); ++row) {
+        if (line.empty() || line == "\r") continue;
+        const auto f = split_csv(line);
+        if (f.size() != header.size()) {
+            throw std::runtime_error("Level analysis " + filename + ": bad row " + std::to_string(row));
+        }
+        try {
+            LevelRating r;
+            r.difficulty = std::stoi(f[difficulty]);
+            r.score = std::stod(f[score]);
+            r.solvable = f[solvable] == "1";
+            r.solution_count = std::stoull(f[solutions]);
+            table->ratings[{f[group], f[level]}] = r;
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Level analysis " + filename + ": bad number in row " + std::to_string(row));
+        }
+    }
+    return table;
+}
+
+const LevelRating* LevelDifficultyTable::find(const std::string& group_id, const std::string& level_id) const {
+    auto it = ratings.find({group_id, level_id});
+    return it == ratings.end() ? nullptr : &it->second;
+}
@@ -0,0 +1,35 @@
+#ifndef LEVEL_DIFFICULTY_H
+#define LEVEL_DIFFICULTY_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+// Ratings written by the level_analyzer tool (its CSV output), looked up by
+// group folder and level id for the /groups listing.
+class LevelRating {
+public:
+    int difficulty = 0;         // 1 (easy) .. 5 (hard), 0 = unsolvable
+    double score = 0;
+    bool solvable = false;
+    uint64_t solution_count = 0;
+};
+
+class LevelDifficultyTable {
+public:
+    // Throws std::runtime_error when the file is missing or is not
+    // level_analyzer CSV.
+    static std::unique_ptr<LevelDifficultyTable> load_csv(const std::string& filename);
+
+    // nullptr when the level was not analysed.
+    const LevelRating* find(const std::string& group_id, const std::string& level_id) const;
+
+    size_t size() const { return ratings.size(); }
+
+private:
+    std::map<std::pair<std::string, std::string>, LevelRating> ratings;
+};
+
+#endif
@@ -0,0 +1,343 @@
+#include "level_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "../game/level_loader.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace levelpack {
+
+uint64_t instance_key(int width, int height, std::vector<int> piece_ids) {
+    std::sort(piece_ids.begin(), piece_ids.end());
+
+    // FNV-1a over (width, height, ids...)
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](int v) {
+        for (int i = 0; i < 4; ++i) {
+            h ^= (uint64_t)((v >> (8 * i)) & 0xff);
+            h *= 1099511628211ull;
+        }
+    };
+    mix(width);
+    mix(height);
+    for (int id : piece_ids) mix(id);
+    return h;
+}
+
+template <typename T>
+static void append(std::vector<char>& buf, const T& value) {
+    const char* p = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+static void align8(std::vector<char>& buf) {
+    while (buf.size() % 8) buf.push_back(0);
+}
+
+std::vector<SourceGroup> read_level_dir(
+    const std::string& root,
+    const std::function<void(const std::string& file, const std::exception& e)>& on_failure,
+    const std::function<void(SourceLevel& level, const LevelData& data)>& on_level) {
+    namespace fs = std::filesystem;
+
+    std::vector<fs::path> group_dirs;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(root, ec)) {
+        if (entry.is_directory()) group_dirs.push_back(entry.path());
+    }
+    if (ec) throw std::runtime_error("cannot read " + root + ": " + ec.message());
+    std::sort(group_dirs.begin(), group_dirs.end());
+
+    std::vector<SourceGroup> groups;
+    for (const auto& dir : group_dirs) {
+        SourceGroup group;
+        group.name = dir.filename().string();
+
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end(), [](const fs::path& a, const fs::path& b) {
+            return a.stem().string() < b.stem().string();
+        });
+
+        for (const auto& file : files) {
+            SourceLevel level;
+            level.id = file.stem().string();
+            try {
+                LevelData ld = LevelLoader::load_level(file.string());
+                level.width = ld.width;
+                level.height = ld.height;
+                for (const auto& p : ld.pieces) level.piece_ids.push_back(p.get_id());
+                if (on_level) on_level(level, ld);
+            } catch (const std::exception& e) {
+                on_failure(file.string(), e);
+                continue;
+            }
+            group.levels.push_back(std::move(level));
+        }
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+std::vector<char> encode_pack(const std::vector<SourceGroup>& groups, bool with_solutions) {
+    std::vector<PackGroup> group_table;
+    std::vector<PackLevel> level_table;
+    std::vector<PackLookup> lookup;
+    std::vector<uint8_t> piece_ids;
+    std::vector<PackPlacement> placements;
+    std::string strings;
+
+    for (const auto& g : groups) {
+        PackGroup pg{};
+        pg.name_offset = (uint32_t)strings.size();
+        pg.name_length = (uint32_t)g.name.size();
+        pg.first_level = (uint32_t)level_table.size();
+        pg.level_count = (uint32_t)g.levels.size();
+        strings += g.name;
+
+        for (const auto& lv : g.levels) {
+            PackLevel pl{};
+            pl.id_offset = (uint32_t)strings.size();
+            pl.id_length = (uint32_t)lv.id.size();
+            strings += lv.id;
+
+            pl.width = (uint16_t)lv.width;
+            pl.height = (uint16_t)lv.height;
+
+            pl.piece_offset = (uint32_t)piece_ids.size();
+            pl.piece_count = (uint32_t)lv.piece_ids.size();
+            for (int id : lv.piece_ids) piece_ids.push_back((uint8_t)id);
+
+            pl.placement_offset = (uint32_t)placements.size();
+            if (with_solutions) {
+                pl.status = lv.status;
+                pl.solution_count = lv.solution_count;
+                for (const auto& p : lv.path) {
+                    placements.push_back(PackPlacement{
+                        (uint8_t)p.get_piece_id(), (uint8_t)p.get_variant_index(),
+                        (int8_t)p.get_offset().x, (int8_t)p.get_offset().y});
+                }
+            }
+            pl.placement_count = (uint32_t)(placements.size() - pl.placement_offset);
+
+            lookup.push_back(PackLookup{instance_key(lv.width, lv.height, lv.piece_ids),
+                                        (uint32_t)level_table.size(), 0});
+            level_table.push_back(pl);
+        }
+        group_table.push_back(pg);
+    }
+
+    std::sort(lookup.begin(), lookup.end(),
+              [](const PackLookup& a, const PackLookup& b) { return a.key < b.key; });
+
+    PackHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.flags = with_solutions ? kFlagSolutions : 0;
+    header.group_count = (uint32_t)group_table.size();
+    header.level_count = (uint32_t)level_table.size();
+
+    std::vector<char> body(sizeof(header));    // the header, copied in once offsets are known
+
+    header.groups_offset = body.size();
+    for (const auto& g : group_table) append(body, g);
+    align8(body);
+    header.levels_offset = body.size();
+    for (const auto& l : level_table) append(body, l);
+    header.lookup_offset = body.size();
+    for (const auto& k : lookup) append(body, k);
+    header.piece_ids_offset = body.size();
+    body.insert(body.end(), piece_ids.begin(), piece_ids.end());
+    align8(body);
+    header.placements_offset = body.size();
+    for (const auto& p : placements) append(body, p);
+    header.strings_offset = body.size();
+    body.insert(body.end(), strings.begin(), strings.end());
+    header.file_size = body.size();
+
+    std::memcpy(body.data(), &header, sizeof(header));
+    return body;
+}
+
+void write_pack(const std::string& filename, const std::vector<SourceGroup>& groups, bool with_solutions) {
+    const std::vector<char> body = encode_pack(groups, with_solutions);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not write level pack: " + filename);
+    }
+    out.write(body.data(), (std::streamsize)body.size());
+    if (!out) {
+        throw std::runtime_error("Short write to level pack: " + filename);
+    }
+}
+
+}  // namespace levelpack
+
+using namespace levelpack;
+
+std::unique_ptr<LevelPack> LevelPack::open(const std::string& filename) {
+    std::unique_ptr<LevelPack> pack(new LevelPack());
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open level pack: " + filename);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PackHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Level pack too small: " + filename);
+    }
+    void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Could not mmap level pack: " + filename);
+    }
+    pack->base = static_cast<const std::byte*>(addr);
+    pack->length = (size_t)st.st_size;
+    pack->mapped = true;
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open level pack: " + filename);
+    }
+    pack->fallback.assign(std::istreambuf_iterator<char>(in), {});
+    pack->base = reinterpret_cast<const std::byte*>(pack->fallback.data());
+    pack->length = pack->fallback.size();
+    if (pack->length < sizeof(PackHeader)) {
+        throw std::runtime_error("Level pack too small: " + filename);
+    }
+#endif
+
+    const PackHeader& h = pack->header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a level pack: " + filename);
+    }
+    if (h.version != kVersion) {
+        throw std::runtime_error("Unsupported level pack version " + std::to_string(h.version));
+    }
+    if (h.file_size != pack->length) {
+        throw std::runtime_error("Truncated level pack: " + filename);
+    }
+    pack->validate(filename);
+    return pack;
+}
+
+// Every offset and length read from the file, so the views handed out by
+// group()/level()/... never leave the mapping. Runs once, at open.
+void LevelPack::validate(const std::string& filename) const {
+    const PackHeader& h = header();
+    const uint64_t len = length;
+    auto bad = [&](const std::string& what) {
+        throw std::runtime_error("Malformed level pack (" + what + "): " + filename);
+    };
+
+    // sections in file order, tables aligned for their element type
+    if (!fits(h.groups_offset, h.group_count, sizeof(PackGroup), h.levels_offset) ||
+        !fits(h.levels_offset, h.level_count, sizeof(PackLevel), h.lookup_offset) ||
+        !fits(h.lookup_offset, h.level_count, sizeof(PackLookup), h.piece_ids_offset) ||
+        h.groups_offset < sizeof(PackHeader) || h.piece_ids_offset > h.placements_offset ||
+        h.placements_offset > h.strings_offset || h.strings_offset > len) {
+        bad("section offsets");
+    }
+    if (h.groups_offset % alignof(PackGroup) || h.levels_offset % alignof(PackLevel) ||
+        h.lookup_offset % alignof(PackLookup) || h.placements_offset % alignof(PackPlacement)) {
+        bad("section alignment");
+    }
+    const uint64_t piece_bytes = h.placements_offset - h.piece_ids_offset;
+    const uint64_t placements = (h.strings_offset - h.placements_offset) / sizeof(PackPlacement);
+    const uint64_t string_bytes = len - h.strings_offset;
+
+    for (uint32_t i = 0; i < h.group_count; ++i) {
+        const PackGroup& g = group(i);
+        if (!fits(g.name_offset, g.name_length, 1, string_bytes) ||
+            !fits(g.first_level, g.level_count, 1, h.level_count)) {
+            bad("group " + std::to_string(i));
+        }
+    }
+    for (uint32_t i = 0; i < h.level_count; ++i) {
+        const PackLevel& lv = level(i);
+        if (!fits(lv.id_offset, lv.id_length, 1, string_bytes) ||
+            !fits(lv.piece_offset, lv.piece_count, 1, piece_bytes) ||
+            !fits(lv.placement_offset, lv.placement_count, 1, placements)) {
+            bad("level " + std::to_string(i));
+        }
+        if (at<PackLookup>(h.lookup_offset)[i].level >= h.level_count) {
+            bad("lookup " + std::to_string(i));
+        }
+    }
+}
+
+LevelPack::~LevelPack() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<std::byte*>(base), length);
+    }
+#endif
+}
+
+const PackHeader& LevelPack::header() const {
+    return *at<PackHeader>(0);
+}
+
+const PackGroup& LevelPack::group(uint32_t index) const {
+    return at<PackGroup>(header().groups_offset)[index];
+}
+
+const PackLevel& LevelPack::level(uint32_t index) const {
+    return at<PackLevel>(header().levels_offset)[index];
+}
+
+std::string_view LevelPack::group_name(const PackGroup& g) const {
+    return {at<char>(header().strings_offset + g.name_offset), g.name_length};
+}
+
+std::string_view LevelPack::level_id(const PackLevel& lv) const {
+    return {at<char>(header().strings_offset + lv.id_offset), lv.id_length};
+}
+
+std::span<const uint8_t> LevelPack::piece_ids(const PackLevel& lv) const {
+    return {at<uint8_t>(header().piece_ids_offset + lv.piece_offset), lv.piece_count};
+}
+
+std::span<const PackPlacement> LevelPack::solution(const PackLevel& lv) const {
+    return {at<PackPlacement>(header().placements_offset) + lv.placement_offset, lv.placement_count};
+}
+
+const PackLevel* LevelPack::find_level(int width, int height, const std::vector<int>& ids) const {
+    const uint64_t key = instance_key(width, height, ids);
+    const PackLookup* first = at<PackLookup>(header().lookup_offset);
+    const PackLookup* last = first + header().level_count;
+
+    auto it = std::lower_bound(first, last, key,
+                               [](const PackLookup& e, uint64_t k) { return e.key < k; });
+
+    std::vector<int> wanted(ids);
+    std::sort(wanted.begin(), wanted.end());
+
+    // verify, since different instances may share a hash
+    for (; it != last && it->key == key; ++it) {
+        const PackLevel& lv = level(it->level);
+        if (lv.width != width || lv.height != height) continue;
+
+        auto stored = piece_ids(lv);
+        std::vector<int> have(stored.begin(), stored.end());
+        std::sort(have.begin(), have.end());
+        if (have == wanted) return &lv;
+    }
+    return nullptr;
+}
@@ -0,0 +1,182 @@
+#ifndef LEVEL_PACK_H
+#define LEVEL_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../engine/placement.h"
+#include "../game/level_data.h"
+
+// levelpack binary format (little endian, offsets are from the file start)
+// --------------------------------
+//   PackHeader
+//   PackGroup[group_count]       sorted by name
+//   PackLevel[level_count]       grouped, sorted by id inside a group
+//   PackLookup[level_count]      sorted by key, for known-level /solve
+//   uint8  piece_ids[]           per level, level-file order
+//   PackPlacement[]              per level, first solution path (optional)
+//   char   strings[]             group names and level ids, not terminated
+//
+// The server maps the file read-only and serves straight out of it.
+namespace levelpack {
+
+constexpr char kMagic[8] = {'P', 'Z', 'L', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kVersion = 1;
+
+constexpr uint32_t kFlagSolutions = 1u << 0;   // placement paths/counts present
+
+enum LevelStatus : uint32_t {
+    kStatusUnknown = 0,     // not solved at pack time
+    kStatusSolved = 1,
+    kStatusUnsolvable = 2,
+};
+
+struct PackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t group_count;
+    uint32_t level_count;
+    uint64_t groups_offset;
+    uint64_t levels_offset;
+    uint64_t lookup_offset;
+    uint64_t piece_ids_offset;
+    uint64_t placements_offset;
+    uint64_t strings_offset;
+    uint64_t file_size;
+};
+
+struct PackGroup {
+    uint32_t name_offset;       // into strings
+    uint32_t name_length;
+    uint32_t first_level;
+    uint32_t level_count;
+};
+
+struct PackLevel {
+    uint32_t id_offset;         // into strings
+    uint32_t id_length;
+    uint16_t width;
+    uint16_t height;
+    uint32_t piece_offset;      // into piece_ids
+    uint32_t piece_count;
+    uint32_t placement_offset;  // into placements
+    uint32_t placement_count;
+    uint32_t status;            // LevelStatus
+    uint64_t solution_count;    // 0 when not counted
+};
+
+struct PackLookup {
+    uint64_t key;               // instance_key(width, height, piece ids)
+    uint32_t level;
+    uint32_t reserved;
+};
+
+struct PackPlacement {
+    uint8_t piece_id;
+    uint8_t variant_index;
+    int8_t x;
+    int8_t y;
+};
+
+static_assert(sizeof(PackHeader) == 80);
+static_assert(sizeof(PackGroup) == 16);
+static_assert(sizeof(PackLevel) == 40);
+static_assert(sizeof(PackLookup) == 16);
+static_assert(sizeof(PackPlacement) == 4);
+
+// `count` items of `size` (> 0) bytes at `offset` lie inside [0, limit),
+// without the overflow of offset + count * size on values from a file.
+inline bool fits(uint64_t offset, uint64_t count, uint64_t size, uint64_t limit) {
+    return offset <= limit && count <= (limit - offset) / size;
+}
+
+// Order-independent key of a puzzle instance (ids are sorted first).
+uint64_t instance_key(int width, int height, std::vector<int> piece_ids);
+
+// ----- writer side (levelpack tool) -----
+
+struct SourceLevel {
+    std::string id;
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;
+    uint32_t status = kStatusUnknown;
+    std::vector<Placement> path;
+    uint64_t solution_count = 0;
+};
+
+struct SourceGroup {
+    std::string name;
+    std::vector<SourceLevel> levels;
+};
+
+// Every <root>/<group>/*.txt, groups sorted by name and levels by id, with
+// the level-file piece order. `on_level`, when given, can fill the solution
+// fields from the loaded level. A file that fails to load (or whose
+// on_level throws) goes to `on_failure` and is left out. Throws
+// std::runtime_error when root cannot be read.
+std::vector<SourceGroup> read_level_dir(
+    const std::string& root,
+    const std::function<void(const std::string& file, const std::exception& e)>& on_failure,
+    const std::function<void(SourceLevel& level, const LevelData& data)>& on_level = {});
+
+// The pack file's bytes.
+std::vector<char> encode_pack(const std::vector<SourceGroup>& groups, bool with_solutions);
+
+// Throws std::runtime_error on I/O failure.
+void write_pack(const std::string& filename, const std::vector<SourceGroup>& groups, bool with_solutions);
+
+}  // namespace levelpack
+
+// Read-only, memory-mapped view of a pack file.
+class LevelPack {
+public:
+    // Throws std::runtime_error when the file is missing or malformed (any
+    // offset or length in it pointing outside the file).
+    static std::unique_ptr<LevelPack> open(const std::string& filename);
+    ~LevelPack();
+
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    bool has_solutions() const { return header().flags & levelpack::kFlagSolutions; }
+
+    uint32_t group_count() const { return header().group_count; }
+    uint32_t level_count() const { return header().level_count; }
+
+    const levelpack::PackGroup& group(uint32_t index) const;
+    const levelpack::PackLevel& level(uint32_t index) const;
+
+    std::string_view group_name(const levelpack::PackGroup& g) const;
+    std::string_view level_id(const levelpack::PackLevel& lv) const;
+    std::span<const uint8_t> piece_ids(const levelpack::PackLevel& lv) const;
+    std::span<const levelpack::PackPlacement> solution(const levelpack::PackLevel& lv) const;
+
+    // Known-level lookup by board size and piece multiset; nullptr if absent.
+    const levelpack::PackLevel* find_level(int width, int height, const std::vector<int>& piece_ids) const;
+
+    const std::byte* data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    LevelPack() = default;
+    const levelpack::PackHeader& header() const;
+    void validate(const std::string& filename) const;   // throws std::runtime_error
+
+    template <typename T>
+    const T* at(uint64_t offset) const { return reinterpret_cast<const T*>(base + offset); }
+
+    const std::byte* base = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<char> fallback;         // used when mmap is unavailable
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "level_watcher.h"
+
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <system_error>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+LevelWatcher::LevelWatcher(LevelCatalogStore& s, int debounce)
+    : store(s), debounce_ms(debounce) {}
+
+LevelWatcher::~LevelWatcher() {
+    stop();
+}
+
+#ifdef __linux__
+
+static constexpr uint32_t kWatchMask =
+    IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+void LevelWatcher::add_watch(const std::string& dir) {
+    int wd = inotify_add_watch(fd, dir.c_str(), kWatchMask);
+    if (wd < 0) {
+        std::cerr << "[WATCH] cannot watch " << dir << "\n";
+        return;
+    }
+    watched_dirs[wd] = dir;
+}
+
+bool LevelWatcher::start() {
+    if (running) return true;
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "[WATCH] inotify unavailable, hot reload disabled\n";
+        return false;
+    }
+
+    const fs::path root(store.get_root());
+    add_watch(root.string());
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(root, ec)) {
+        if (entry.is_directory()) add_watch(entry.path().string());
+    }
+
+    running = true;
+    worker = std::thread(&LevelWatcher::run, this);
+    std::cerr << "[WATCH] watching " << watched_dirs.size() << " directories\n";
+    return true;
+}
+
+void LevelWatcher::stop() {
+    if (!running.exchange(false)) return;
+    if (worker.joinable()) worker.join();
+    close(fd);
+    fd = -1;
+    watched_dirs.clear();
+}
+
+void LevelWatcher::run() {
+    alignas(inotify_event) char buf[4096];
+    std::set<std::string> pending;
+
+    while (running) {
+        pollfd pfd{fd, POLLIN, 0};
+        // wait short while events are pending so bursts are coalesced
+        int ready = poll(&pfd, 1, pending.empty() ? 500 : debounce_ms);
+
+        if (ready <= 0) {
+            if (!pending.empty()) {
+                store.reload_paths(std::vector<std::string>(pending.begin(), pending.end()));
+                pending.clear();
+            }
+            continue;
+        }
+
+        ssize_t len = read(fd, buf, sizeof(buf));
+        for (ssize_t i = 0; i < len;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(buf + i);
+            i += sizeof(inotify_event) + ev->len;
+
+            auto it = watched_dirs.find(ev->wd);
+            if (it == watched_dirs.end()) continue;
+
+            if (ev->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                pending.insert(it->second);
+                watched_dirs.erase(it);
+                continue;
+            }
+            if (ev->len == 0) continue;
+
+            const fs::path changed = fs::path(it->second) / ev->name;
+            if ((ev->mask & IN_ISDIR) && (ev->mask & (IN_CREATE | IN_MOVED_TO))) {
+                add_watch(changed.string());    // new group folder
+            }
+            if ((ev->mask & IN_ISDIR) || changed.extension() == ".txt") {
+                pending.insert(changed.string());
+            }
+        }
+    }
+}
+
+#else
+
+void LevelWatcher::add_watch(const std::string&) {}
+
+bool LevelWatcher::start() {
+    std::cerr << "[WATCH] hot reload needs inotify (Linux only)\n";
+    return false;
+}
+
+void LevelWatcher::stop() {}
+
+void LevelWatcher::run() {}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef LEVEL_WATCHER_H
+#define LEVEL_WATCHER_H
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "level_catalog.h"
+
+// Watches LEVEL_DIR (and every group folder in it) with inotify and asks the
+// store to reparse only the paths that changed. Events are batched for a short
+// quiet period so an editor's write+rename sequence becomes one reload.
+class LevelWatcher {
+public:
+    explicit LevelWatcher(LevelCatalogStore& store, int debounce_ms = 200);
+    ~LevelWatcher();
+
+    LevelWatcher(const LevelWatcher&) = delete;
+    LevelWatcher& operator=(const LevelWatcher&) = delete;
+
+    bool start();   // false when inotify is unavailable (non-Linux, limits)
+    void stop();
+
+private:
+    void run();
+    void add_watch(const std::string& dir);
+
+    LevelCatalogStore& store;
+    int debounce_ms;
+
+    int fd = -1;
+    std::map<int, std::string> watched_dirs;   // inotify wd -> directory
+    std::atomic<bool> running{false};
+    std::thread worker;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "prefork.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+static int g_worker_index = -1;
+
+int prefork_worker_index() {
+    return g_worker_index;
+}
+
+#ifdef _WIN32
+
+// no fork(): one in-process worker
+int run_prefork(const PreforkOptions&, const std::function<int(int)>& worker) {
+    g_worker_index = 0;
+    return worker(0);
+}
+
+#else
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void on_stop_signal(int) {
+    g_stop = 1;
+}
+
+class Slot {
+public:
+    pid_t pid = -1;
+    Clock::time_point started;
+    Clock::time_point next_start;   // when to (re)start it, while pid == -1
+    int backoff_ms = 0;
+};
+
+void set_stop_handlers(void (*handler)(int)) {
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGTERM, &sa, nullptr);
+    sigaction(SIGINT, &sa, nullptr);
+}
+
+pid_t spawn(int index, const std::function<int(int)>& worker) {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    const pid_t parent = getpid();
+    const pid_t pid = fork();
+    if (pid != 0) return pid;   // supervisor, or -1
+
+    set_stop_handlers(SIG_DFL);
+#ifdef __linux__
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+    if (getppid() != parent) std::_Exit(0);    // supervisor already gone
+
+    g_worker_index = index;
+    int status = 1;
+    try {
+        status = worker(index);
+    } catch (const std::exception& e) {
+        std::cerr << "[PREFORK] worker " << index << ": " << e.what() << "\n";
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    // skip the supervisor's atexit handlers and static destructors
+    std::_Exit(status);
+}
+
+std::string describe(int status) {
+    if (WIFSIGNALED(status)) return "killed by signal " + std::to_string(WTERMSIG(status));
+    return "exited with status " + std::to_string(WEXITSTATUS(status));
+}
+
+void stop_workers(std::vector<Slot>& slots, int timeout_ms) {
+    for (const auto& s : slots) {
+        if (s.pid > 0) kill(s.pid, SIGTERM);
+    }
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (;;) {
+        bool alive = false;
+        for (auto& s : slots) {
+            if (s.pid > 0 && waitpid(s.pid, nullptr, WNOHANG) == s.pid) s.pid = -1;
+            alive = alive || s.pid > 0;
+        }
+        if (!alive) return;
+        if (Clock::now() >= deadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    for (auto& s : slots) {
+        if (s.pid <= 0) continue;
+        std::cerr << "[PREFORK] worker pid " << s.pid << " ignored SIGTERM, killing it\n";
+        kill(s.pid, SIGKILL);
+        waitpid(s.pid, nullptr, 0);
+        s.pid = -1;
+    }
+}
+
+}  // namespace
+
+int run_prefork(const PreforkOptions& options, const std::function<int(int)>& worker) {
+    g_stop = 0;
+    set_stop_handlers(on_stop_signal);
+
+    std::vector<Slot> slots(std::max(1, options.workers));
+    for (auto& s : slots) s.next_start = Clock::now();
+    std::cerr << "[PREFORK] supervisor pid " << getpid() << ", " << slots.size() << " workers\n";
+
+    while (!g_stop) {
+        // reap
+        int status = 0;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            auto it = std::find_if(slots.begin(), slots.end(), [&](const Slot& s) { return s.pid == pid; });
+            if (it == slots.end()) continue;
+
+            const auto now = Clock::now();
+            const bool crash_loop = now - it->started < std::chrono::milliseconds(options.min_uptime_ms);
+            it->backoff_ms = crash_loop ? std::min(options.max_backoff_ms, std::max(100, it->backoff_ms * 2)) : 0;
+            it->pid = -1;
+            it->next_start = now + std::chrono::milliseconds(it->backoff_ms);
+            std::cerr << "[PREFORK] worker " << (it - slots.begin()) << " (pid " << pid << ") "
+                      << describe(status) << ", restarting in " << it->backoff_ms << " ms\n";
+        }
+
+        // (re)start
+        for (size_t i = 0; i < slots.size() && !g_stop; ++i) {
+            Slot& s = slots[i];
+            if (s.pid > 0 || Clock::now() < s.next_start) continue;
+            s.pid = spawn((int)i, worker);
+            if (s.pid < 0) {
+                std::cerr << "[PREFORK] fork failed: " << std::strerror(errno) << "\n";
+                s.next_start = Clock::now() + std::chrono::milliseconds(options.max_backoff_ms);
+                continue;
+            }
+            s.started = Clock::now();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    std::cerr << "[PREFORK] stopping workers\n";
+    stop_workers(slots, options.stop_timeout_ms);
+    set_stop_handlers(SIG_DFL);
+    return 0;
+}
+
+#endif
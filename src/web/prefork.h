@@ -0,0 +1,35 @@
+#ifndef PREFORK_H
+#define PREFORK_H
+
+#include <functional>
+
+class PreforkOptions {
+public:
+    int workers = 2;
+    int min_uptime_ms = 1000;       // a worker that dies sooner is crash-looping
+    int max_backoff_ms = 5000;      // longest wait before restarting one
+    int stop_timeout_ms = 5000;     // SIGTERM to SIGKILL on shutdown
+};
+
+// Supervisor for a pool of identical worker processes (POSIX only).
+// --------------------------------
+// Forks `workers` children that each run worker(index) and exit with its
+// result. Each worker binds its own listening socket; with SO_REUSEPORT
+// (httplib's default) the kernel spreads connections over them, so workers
+// share no locks, allocator or accept queue, and a crash takes down one
+// worker's requests only. Anything they should share read-only belongs in a
+// file each maps (see LevelPack).
+//
+// A worker that exits for any reason is started again, right away if it ran
+// for at least min_uptime_ms, otherwise after a doubling backoff. SIGTERM or
+// SIGINT stops the pool: the workers get SIGTERM, then SIGKILL after
+// stop_timeout_ms. Workers also get SIGTERM when the supervisor dies.
+//
+// Call before starting any thread: only the forking thread survives fork().
+// Returns the supervisor's exit status (0 after a requested stop).
+int run_prefork(const PreforkOptions& options, const std::function<int(int index)>& worker);
+
+// Index of the calling worker process, -1 outside run_prefork().
+int prefork_worker_index();
+
+#endif
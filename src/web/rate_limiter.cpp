@@ -0,0 +1,65 @@
+#include "rate_limiter.h"
+
+#include <algorithm>
+#include <functional>
+
+RateLimiter::RateLimiter(const RateLimitConfig& c) : config(c) {
+    config.shards = std::max<size_t>(1, config.shards);
+    config.capacity = std::max(1.0, config.capacity);
+    config.refill_per_second = std::max(1e-9, config.refill_per_second);
+    config.max_clients_per_shard = std::max<size_t>(1, config.max_clients_per_shard);
+    shards.reset(new Shard[config.shards]);
+}
+
+void RateLimiter::refill(Bucket& b, Clock::time_point now) const {
+    const double elapsed = std::chrono::duration<double>(now - b.last).count();
+    if (elapsed > 0) {
+        b.tokens = std::min(config.capacity, b.tokens + elapsed * config.refill_per_second);
+        b.last = now;
+    }
+}
+
+RateDecision RateLimiter::acquire(const std::string& client, double cost, Clock::time_point now) {
+    cost = std::clamp(cost, 0.0, config.capacity);
+    Shard& shard = shards[std::hash<std::string>{}(client) % config.shards];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.buckets.find(client);
+    if (it == shard.buckets.end()) {
+        while (!shard.lru.empty() && shard.buckets.size() >= config.max_clients_per_shard) {
+            shard.buckets.erase(shard.lru.back());
+            shard.lru.pop_back();
+        }
+        shard.lru.push_front(client);
+        it = shard.buckets.emplace(client, Bucket{config.capacity, now, shard.lru.begin()}).first;
+    } else {
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.recency);
+    }
+    Bucket& b = it->second;
+    refill(b, now);
+
+    RateDecision d;
+    d.limit = config.capacity;
+    d.allowed = b.tokens >= cost;
+    if (d.allowed) {
+        b.tokens -= cost;
+    } else {
+        d.retry_after = (cost - b.tokens) / config.refill_per_second;
+    }
+    d.remaining = b.tokens;
+    d.reset_after = (config.capacity - b.tokens) / config.refill_per_second;
+    return d;
+}
+
+size_t RateLimiter::client_count() const {
+    size_t n = 0;
+    for (size_t i = 0; i < config.shards; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        n += shards[i].buckets.size();
+    }
+    return n;
+}
+
+double solve_cost(int width, int height, size_t piece_count) {
+    return (double)std::max(0, width) * (double)std::max(0, height) * (double)std::max<size_t>(1, piece_count);
+}
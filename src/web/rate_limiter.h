@@ -0,0 +1,79 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Per-client token buckets for the solve endpoints.
+// --------------------------------
+// Each client (IP) has a bucket of `capacity` tokens refilled at
+// `refill_per_second`. A request takes its estimated cost in tokens (see
+// solve_cost), so one large custom board uses up as much as many small
+// levels. A request that does not fit is refused with the time until it
+// would.
+//
+// Clients are spread over independent shards (hash of the client id), each
+// with its own mutex and map, so concurrent requests from different clients
+// rarely touch the same lock. A shard holds at most max_clients_per_shard
+// clients: a new one pushes out the client seen least recently (O(1), kept in
+// a recency list). That client most likely refilled completely anyway; if not,
+// it starts over with a full bucket, which only a flood of new client ids can
+// force.
+class RateLimitConfig {
+public:
+    double capacity = 4000;             // burst, in cost units
+    double refill_per_second = 1000;
+    size_t shards = 16;
+    size_t max_clients_per_shard = 4096;
+};
+
+class RateDecision {
+public:
+    bool allowed = true;
+    double limit = 0;               // capacity
+    double remaining = 0;           // tokens left after this request
+    double retry_after = 0;         // seconds until the request would fit (when refused)
+    double reset_after = 0;         // seconds until the bucket is full again
+};
+
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RateLimiter(const RateLimitConfig& config = RateLimitConfig{});
+
+    // Costs above capacity are charged as capacity, so every request can run
+    // once the bucket is full.
+    RateDecision acquire(const std::string& client, double cost, Clock::time_point now = Clock::now());
+
+    size_t client_count() const;
+    const RateLimitConfig& get_config() const { return config; }
+
+private:
+    struct Bucket {
+        double tokens;
+        Clock::time_point last;
+        std::list<std::string>::iterator recency;   // into Shard::lru
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Bucket> buckets;
+        std::list<std::string> lru;                 // client ids, most recent first
+    };
+
+    void refill(Bucket& b, Clock::time_point now) const;
+
+    RateLimitConfig config;
+    std::unique_ptr<Shard[]> shards;
+};
+
+// Estimated work of a solve request: board area x piece count.
+double solve_cost(int width, int height, size_t piece_count);
+
+#endif
@@ -0,0 +1,91 @@
+#include "request_timing.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define REQUEST_TIMING_TSC 1
+#endif
+
+static uint64_t steady_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// cpuid 0x80000007, EDX bit 8: the TSC ticks at a constant rate in every
+// P-/C-state, so it can measure wall time.
+static bool detect_invariant_tsc() {
+#ifdef REQUEST_TIMING_TSC
+    unsigned a, b, c, d;
+    if (__get_cpuid(0x80000000, &a, &b, &c, &d) && a >= 0x80000007 &&
+        __get_cpuid(0x80000007, &a, &b, &c, &d)) {
+        return (d >> 8) & 1;
+    }
+#endif
+    return false;
+}
+
+static const bool g_tsc = detect_invariant_tsc();
+
+bool SpanClock::uses_tsc() {
+    return g_tsc;
+}
+
+uint64_t SpanClock::now() {
+#ifdef REQUEST_TIMING_TSC
+    if (g_tsc) return __rdtsc();
+#endif
+    return steady_ns();
+}
+
+static double measure_ms_per_tick() {
+    if (!g_tsc) return 1e-6;
+    const uint64_t ns0 = steady_ns();
+    const uint64_t t0 = SpanClock::now();
+    while (steady_ns() - ns0 < 10'000'000) {
+    }
+    const uint64_t ns1 = steady_ns();
+    const uint64_t t1 = SpanClock::now();
+    return (double)(ns1 - ns0) * 1e-6 / (double)(t1 - t0);
+}
+
+static double ms_per_tick() {
+    static const double rate = measure_ms_per_tick();
+    return rate;
+}
+
+void SpanClock::calibrate() {
+    ms_per_tick();
+}
+
+double SpanClock::to_ms(uint64_t ticks) {
+    return (double)ticks * ms_per_tick();
+}
+
+void RequestTimer::add(const char* name, uint64_t from) {
+    const uint64_t elapsed = SpanClock::now() - from;
+    for (int i = 0; i < count; ++i) {
+        if (names[i] == name || std::strcmp(names[i], name) == 0) {
+            ticks[i] += elapsed;
+            return;
+        }
+    }
+    if (count == kMaxSpans) return;
+    names[count] = name;
+    ticks[count] = elapsed;
+    ++count;
+}
+
+std::string RequestTimer::server_timing() const {
+    std::string out;
+    char buf[64];
+    for (int i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "%s;dur=%.3f, ", names[i], span_ms(i));
+        out += buf;
+    }
+    std::snprintf(buf, sizeof(buf), "total;dur=%.3f", total_ms());
+    return out + buf;
+}
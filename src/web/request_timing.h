@@ -0,0 +1,71 @@
+#ifndef REQUEST_TIMING_H
+#define REQUEST_TIMING_H
+
+#include <cstdint>
+#include <string>
+
+// Cheap timestamps for per-request phase timing.
+// --------------------------------
+// On x86-64 with an invariant TSC, now() is one rdtsc (a few ns); ticks are
+// converted to time with a rate measured once against steady_clock. Other
+// CPUs fall back to steady_clock in nanoseconds.
+class SpanClock {
+public:
+    static uint64_t now();
+    static double to_ms(uint64_t ticks);
+
+    // Measures the tick rate (about 10 ms). Called by the first to_ms();
+    // call it at startup to keep that off a request.
+    static void calibrate();
+
+    static bool uses_tsc();
+};
+
+// Named phases of one request, reported as a Server-Timing header.
+// --------------------------------
+// Spans are stored in a fixed array (no allocation); a phase entered twice
+// accumulates. Not thread-safe: one timer per request.
+class RequestTimer {
+public:
+    static constexpr int kMaxSpans = 12;
+
+    RequestTimer() : start(SpanClock::now()) {}
+
+    // Adds the time since `from` (a SpanClock::now() value) to `name`, which
+    // must be a string literal. Spans past kMaxSpans are dropped.
+    void add(const char* name, uint64_t from);
+
+    // "parse;dur=0.031, search;dur=1.204, total;dur=1.310"
+    std::string server_timing() const;
+
+    int span_count() const { return count; }
+    const char* span_name(int i) const { return names[i]; }
+    double span_ms(int i) const { return SpanClock::to_ms(ticks[i]); }
+    double total_ms() const { return SpanClock::to_ms(SpanClock::now() - start); }
+
+private:
+    uint64_t start;
+    int count = 0;
+    const char* names[kMaxSpans];
+    uint64_t ticks[kMaxSpans];
+};
+
+// Times a scope into `timer` (may be nullptr).
+class ScopedSpan {
+public:
+    ScopedSpan(RequestTimer* timer, const char* name)
+        : timer(timer), name(name), from(timer ? SpanClock::now() : 0) {}
+    ~ScopedSpan() {
+        if (timer) timer->add(name, from);
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    RequestTimer* timer;
+    const char* name;
+    uint64_t from;
+};
+
+#endif
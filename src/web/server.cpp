@@ -1,12 +1,33 @@
 #include <iostream>
 #include <string>
-#include <cstdlib>      // getenv
+#include <cstdlib>      // getenv, mkstemp
 #include <filesystem>
 #include <system_error>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <cerrno>
+#include <cstring>      // strerror
+#include <stdexcept>
+#include <unistd.h>     // getpid, write, unlink
 
 #include "../engine/piece_library.h"
+#include "../engine/portfolio_solver.h"
 #include "../game/level_data.h"
 #include "../game/level_loader.h"
+#include "hint_service.h"
+#include "json_body.h"
+#include "level_catalog.h"
+#include "level_difficulty.h"
+#include "level_pack.h"
+#include "level_watcher.h"
+#include "prefork.h"
+#include "rate_limiter.h"
+#include "request_timing.h"
+#include "solve_coalescer.h"
 #include "solve_api.h"
 
 #include "httplib.h"
@@ -16,92 +37,183 @@ using json = nlohmann::json;
 namespace fs = std::filesystem;
 
 
-struct LevelGroup {
-    std::string id;      // group folder name 
-    std::string name;    // 先同 id
-    std::vector<LevelInfo> levels;
-};
+static std::string level_root() {
+    if (const char* p = std::getenv("LEVEL_DIR")) return p;
+    return "levels";
+}
 
-std::vector<LevelGroup> g_groups;
+// Catalogue snapshot store; /groups readers only do an atomic load.
+static LevelCatalogStore g_catalog(level_root());
 
-void load_all_levels() {
-    g_groups.clear();
+// Per-level solution sets for POST /hint, dropped whenever the catalogue reloads.
+static HintService g_hints;
 
-    std::cerr << "[LEVEL] load_all_levels() enter\n";
+// Identical /solve requests in flight share one solver run.
+static SolveCoalescer g_solve_flights;
 
-    std::error_code ec; 
-    std::string root = "levels";
-    if (const char* p = std::getenv("LEVEL_DIR")) root = p;
+// Optional offline solutions (SOLUTION_DB=path, built by `solutiondb`).
+static std::unique_ptr<SolutionDb> g_solution_db;
 
-    std::cerr << "[LEVEL] cwd=" << fs::current_path(ec).string() << "\n";
-    std::cerr << "[LEVEL] root=" << root << "\n";
-    std::cerr << "[LEVEL] exists=" << (fs::exists(root, ec) ? "yes" : "no") << "\n";
-    std::cerr << "[LEVEL] is_dir=" << (fs::is_directory(root, ec) ? "yes" : "no") << "\n";
-    for (const auto& groupEntry : fs::directory_iterator(root, ec)) {
-        if (ec) {
-            std::cerr << "[LEVEL] iterator error: " << ec.message() << "\n";
-            return;
-        }
+static void open_solution_db() {
+    const char* p = std::getenv("SOLUTION_DB");
+    if (!p) return;
+    try {
+        g_solution_db = SolutionDb::open(p);
+        g_hints.set_solution_db(g_solution_db.get());
+        std::cerr << "[SOLDB] loaded " << p << " (levels=" << g_solution_db->level_count() << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[SOLDB] " << e.what() << ", hints fall back to solving\n";
+    }
+}
 
-        if (!groupEntry.is_directory()) continue;
+// Optional difficulty ratings for /groups (LEVEL_ANALYSIS=path to the CSV
+// written by `level_analyzer`).
+static std::unique_ptr<LevelDifficultyTable> g_difficulty;
+
+static void open_level_analysis() {
+    const char* p = std::getenv("LEVEL_ANALYSIS");
+    if (!p) return;
+    try {
+        g_difficulty = LevelDifficultyTable::load_csv(p);
+        std::cerr << "[ANALYZE] loaded " << p << " (levels=" << g_difficulty->size() << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[ANALYZE] " << e.what() << ", /groups without difficulty\n";
+    }
+}
 
-        const auto groupPath = groupEntry.path();
-        const auto groupName = groupPath.filename().string();
-        std::cerr << "[GROUP] " << groupName << "\n";
-        LevelGroup group;
-        group.id = groupName;
-        group.name = groupName;
+static void add_difficulty(json& level, const std::string& group_id, const std::string& level_id) {
+    if (!g_difficulty) return;
+    if (const LevelRating* r = g_difficulty->find(group_id, level_id)) {
+        level["difficulty"] = r->difficulty;
+    }
+}
 
-        for (const auto& fileEntry : fs::directory_iterator(groupPath, ec)) {
-            if (ec) {
-                std::cerr << "[LEVEL] iterator error: " << ec.message() << "\n";
-                return;
-            }
-            if (!fileEntry.is_regular_file()) continue;
-            if (fileEntry.path().extension() != ".txt") continue;
-
-            // std::cerr << "  - " << fileEntry.path().filename().string() << "\n";
-            try {
-                LevelData ld = LevelLoader::load_level(fileEntry.path().string());
-                std::cerr << "  - " << fileEntry.path().filename().string()
-                        << " (" << ld.width << "x" << ld.height
-                        << ", pieces=" << ld.pieces.size() << ")\n";
-                LevelInfo li;
-                li.id = fileEntry.path().stem().string();      // level1
-                li.name = li.id;
-                li.width = ld.width;
-                li.height = ld.height;
-
-                // pieceIds：從 ld.pieces 抽 id，並去重 + 排序
-                std::vector<int> ids;
-                ids.reserve(ld.pieces.size());
-                for (const auto& pc : ld.pieces) {
-                    ids.push_back(pc.get_id());
-                }
-                std::sort(ids.begin(), ids.end());
-                ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
-                li.pieceIds = std::move(ids);
-
-                group.levels.push_back(std::move(li));
-            } catch (const std::exception& e) {
-                std::cerr << "  - " << fileEntry.path().filename().string()
-                        << " [LOAD FAIL] " << e.what() << "\n";
-            }
+// "perf": true on /solve is honoured only with SOLVE_PERF=1: opening
+// counters costs syscalls, and they describe the host to the caller.
+static bool solve_perf_enabled() {
+    static const bool on = [] {
+        const char* p = std::getenv("SOLVE_PERF");
+        return p && std::string(p) == "1";
+    }();
+    return on;
+}
+
+static bool hot_reload_enabled() {
+    const char* p = std::getenv("LEVEL_WATCH");
+    return !(p && std::string(p) == "0");
+}
+
+// Optional precompiled catalogue (LEVEL_PACK=path, built by `levelpack`).
+// When present it replaces the directory scan and the watcher.
+static std::unique_ptr<LevelPack> g_pack;
+
+static void open_level_pack() {
+    const char* p = std::getenv("LEVEL_PACK");
+    if (!p) return;
+    try {
+        g_pack = LevelPack::open(p);
+        std::cerr << "[PACK] mapped " << p << " (" << g_pack->size() << " bytes, groups="
+                  << g_pack->group_count() << ", levels=" << g_pack->level_count() << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[PACK] " << e.what() << ", falling back to LEVEL_DIR\n";
+        g_pack.reset();
+    }
+}
+
+static json groups_json(const LevelCatalog& catalog) {
+    json out;
+    out["groups"] = json::array();
+
+    for (const auto& g : catalog.groups) {
+        json gj;
+        gj["groupId"] = g.id;
+        gj["name"] = g.name;
+
+        json levels = json::array();
+        for (const auto& lv : g.levels) {
+            json lj = {
+                {"id", lv.id},
+                {"name", lv.name},
+                {"width", lv.width},
+                {"height", lv.height},
+                {"pieceIds", lv.pieceIds}
+            };
+            add_difficulty(lj, g.id, lv.id);
+            levels.push_back(std::move(lj));
+        }
+        gj["levels"] = std::move(levels);
+
+        out["groups"].push_back(std::move(gj));
+    }
+    out["generation"] = catalog.generation;
+    return out;
+}
 
-            
+static json groups_json(const LevelPack& pack) {
+    json out;
+    out["groups"] = json::array();
+
+    for (uint32_t gi = 0; gi < pack.group_count(); ++gi) {
+        const auto& g = pack.group(gi);
+        json gj;
+        gj["groupId"] = pack.group_name(g);
+        gj["name"] = pack.group_name(g);
+
+        json levels = json::array();
+        for (uint32_t li = 0; li < g.level_count; ++li) {
+            const auto& lv = pack.level(g.first_level + li);
+
+            // same shape as the directory catalogue: sorted, unique ids
+            auto raw = pack.piece_ids(lv);
+            std::vector<int> ids(raw.begin(), raw.end());
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+            json lj = {
+                {"id", pack.level_id(lv)},
+                {"name", pack.level_id(lv)},
+                {"width", lv.width},
+                {"height", lv.height},
+                {"pieceIds", ids}
+            };
+            if (lv.solution_count > 0) {
+                lj["solutionCount"] = lv.solution_count;
+            }
+            add_difficulty(lj, std::string(pack.group_name(g)), std::string(pack.level_id(lv)));
+            levels.push_back(std::move(lj));
         }
-        g_groups.emplace_back(std::move(group));
+        gj["levels"] = std::move(levels);
+
+        out["groups"].push_back(std::move(gj));
     }
+    return out;
+}
+
+// Answer a known level straight from the pack; false if it is not in there.
+// A request naming an engine wants that engine to search, so it never is.
+static bool solve_from_pack(const SolveRequest& sr, SolveResult& out) {
+    if (!g_pack || !g_pack->has_solutions() || sr.piece_ids.empty()) return false;
+    if (!sr.engine.empty() && sr.engine != "auto") return false;
 
-    std::sort(g_groups.begin(), g_groups.end(),
-            [](const LevelGroup& a, const LevelGroup& b) {
-                return a.name < b.name;
-            });
+    const auto* lv = g_pack->find_level(sr.width, sr.height, sr.piece_ids);
+    if (!lv) return false;
 
-    std::cerr << "[INFO] loaded groups=" << g_groups.size() << "\n";
-    for (const auto& g : g_groups) {
-        std::cerr << "  [G] " << g.name << " levels=" << g.levels.size() << "\n";
+    if (lv->status == levelpack::kStatusUnsolvable) {
+        out = SolveResult{};
+        out.error_message = "No solution (known from the level pack).";
+        out.engine = "pack";
+        return true;
     }
+    if (lv->status != levelpack::kStatusSolved) return false;
+
+    std::vector<Placement> path;
+    path.reserve(lv->placement_count);
+    for (const auto& p : g_pack->solution(*lv)) {
+        path.emplace_back(p.piece_id, p.variant_index, Cell{p.x, p.y});
+    }
+    out = make_solve_result(PieceLibrary::get_piece_by_id(sr.piece_ids), path);
+    out.engine = "pack";
+    return true;
 }
 
 
@@ -122,36 +234,321 @@ static void add_cors(httplib::Response& res) {
     res.set_header("Access-Control-Allow-Headers", "Content-Type");
 }
 
-static json to_json(const SolveResult& r) {
+// Body in the encoding the client accepts (see encode_body).
+static void send_json(const httplib::Request& req, httplib::Response& res, const json& body) {
+    EncodedBody out = encode_body(body, req.get_header_value("Accept"));
+    res.set_header("Vary", "Accept");
+    res.set_content(std::move(out.content), out.content_type);
+}
+
+// Debug counters of a "perf" /solve. Per-node and per-test values are null
+// when the event is missing or the engine keeps no search counters.
+static json perf_json(const SolveResult& r) {
+    const PerfReport& p = r.perf_report;
+    json counters = json::object(), per_node = json::object(), per_test = json::object();
+    bool any = false;
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        const PerfEvent e = (PerfEvent)i;
+        const bool has = p.sample.has(e);
+        any = any || has;
+        counters[to_string(e)] = has ? json(p.sample.get(e)) : json(nullptr);
+        per_node[to_string(e)] = has && p.stats.nodes > 0 ? json(p.per_node(e)) : json(nullptr);
+        per_test[to_string(e)] = has && p.stats.placement_tests > 0 ? json(p.per_test(e)) : json(nullptr);
+    }
+
+    json j;
+    j["available"] = any;
+    j["error"] = r.perf_error;
+    j["nodes"] = p.stats.nodes;
+    j["placementTests"] = p.stats.placement_tests;
+    j["counters"] = std::move(counters);
+    j["perNode"] = std::move(per_node);
+    j["perTest"] = std::move(per_test);
+    j["ipc"] = p.sample.has(PerfEvent::Cycles) && p.sample.has(PerfEvent::Instructions) ? json(p.ipc())
+                                                                                       : json(nullptr);
+    return j;
+}
+
+static json to_json(const SolveResult& r, int index_width = 0) {
     json j;
     j["solved"] = r.solved;
 
     j["error"] = r.error_message;
+    j["placements"] = placements_json(r.placements, index_width);
+    if (!r.strategy.empty()) {
+        j["strategy"] = r.strategy;
+    }
+    if (!r.engine.empty()) {
+        j["engine"] = r.engine;
+    }
+    if (r.perf) {
+        j["perf"] = perf_json(r);
+    }
+    return j;
+}
 
-    json placements = json::array();
-    for (const auto& p : r.placements) {
-        json pj;
-        pj["pieceId"] = p.pieceId;
-        pj["variantIndex"] = p.variantIndex; // debug 用
+// A page of /solve solutions; nextCursor is null once the search is exhausted.
+static json to_json(const SolvePage& page, int index_width = 0) {
+    json j;
+    j["solved"] = !page.solutions.empty();
+    j["error"] = page.error_message;
+    json solutions = json::array();
+    for (const auto& s : page.solutions) solutions.push_back(placements_json(s, index_width));
+    j["solutions"] = std::move(solutions);
+    j["firstIndex"] = page.first_index;
+    j["nextCursor"] = page.next_cursor.empty() ? json(nullptr) : json(page.next_cursor);
+    j["nodes"] = page.nodes;
+    j["engine"] = "iterative";
+    return j;
+}
+
+// Most threads one /solve may race with "portfolio" (PORTFOLIO_MAX_THREADS,
+// default: the core count, at most one per strategy).
+static int portfolio_thread_cap() {
+    static const int cap = [] {
+        int n = (int)std::max(1u, std::thread::hardware_concurrency());
+        if (const char* p = std::getenv("PORTFOLIO_MAX_THREADS")) n = std::atoi(p);
+        return std::clamp(n, 0, kPortfolioStrategies);
+    }();
+    return cap;
+}
+
+// Slow-request log: /solve calls over SLOW_REQUEST_MS (default 1000, < 0
+// off) are written as one JSON line with the instance and the phase times,
+// to SLOW_REQUEST_LOG (appended) or stderr.
+static double g_slow_request_ms = 1000;
+static std::unique_ptr<std::ofstream> g_slow_log;
+static std::mutex g_slow_log_mutex;
+
+static void open_slow_request_log() {
+    if (const char* p = std::getenv("SLOW_REQUEST_MS")) g_slow_request_ms = std::atof(p);
+    if (const char* p = std::getenv("SLOW_REQUEST_LOG")) {
+        g_slow_log = std::make_unique<std::ofstream>(p, std::ios::app);
+        if (!*g_slow_log) {
+            std::cerr << "[SLOW] could not open " << p << ", logging to stderr\n";
+            g_slow_log.reset();
+        }
+    }
+    SpanClock::calibrate();
+}
+
+static void log_if_slow(const httplib::Request& req, const SolveRequest& sr, const SolveResult& result,
+                        const RequestTimer& timer) {
+    const double ms = timer.total_ms();
+    if (g_slow_request_ms < 0 || ms < g_slow_request_ms) return;
+
+    json line;
+    line["time"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    line["path"] = req.path;
+    line["client"] = req.remote_addr;
+    line["ms"] = ms;
+    line["width"] = sr.width;
+    line["height"] = sr.height;
+    line["pieceIds"] = sr.piece_ids;
+    line["portfolio"] = sr.portfolio_threads;
+    line["solved"] = result.solved;
+    if (!result.strategy.empty()) line["strategy"] = result.strategy;
+    json spans = json::object();
+    for (int i = 0; i < timer.span_count(); ++i) spans[timer.span_name(i)] = timer.span_ms(i);
+    line["spans"] = std::move(spans);
+
+    std::lock_guard<std::mutex> lock(g_slow_log_mutex);
+    if (g_slow_log) {
+        *g_slow_log << line.dump() << std::endl;
+    } else {
+        std::cerr << "[SLOW] " << line.dump() << "\n";
+    }
+}
+
+// Per-client admission control for /solve and /solve/trace (RATE_LIMIT=0
+// turns it off). Burst and refill are in cost units, see solve_cost. Every
+// prefork worker keeps its own buckets, so each gets 1/workers of the
+// configured capacity and refill: a client whose connections all land on
+// one worker gets that share, one spread over all of them the whole.
+static std::unique_ptr<RateLimiter> g_rate_limiter;
+static bool g_rate_limit_trust_proxy = false;
+
+static void open_rate_limiter(int workers) {
+    const char* on = std::getenv("RATE_LIMIT");
+    if (on && std::string(on) == "0") return;
+
+    RateLimitConfig config;
+    if (const char* p = std::getenv("RATE_LIMIT_CAPACITY")) config.capacity = std::atof(p);
+    if (const char* p = std::getenv("RATE_LIMIT_REFILL")) config.refill_per_second = std::atof(p);
+    if (const char* p = std::getenv("RATE_LIMIT_TRUST_PROXY")) g_rate_limit_trust_proxy = std::string(p) == "1";
+    config.capacity /= workers;
+    config.refill_per_second /= workers;
+
+    g_rate_limiter = std::make_unique<RateLimiter>(config);
+    config = g_rate_limiter->get_config();
+    std::cerr << "[RATE] capacity=" << config.capacity << " refill=" << config.refill_per_second << "/s"
+              << (workers > 1 ? " per worker (" + std::to_string(workers) + " workers)" : std::string())
+              << (g_rate_limit_trust_proxy ? " (X-Forwarded-For)" : "") << "\n";
+}
+
+// The peer address, or the first X-Forwarded-For hop behind a trusted proxy.
+static std::string client_id(const httplib::Request& req) {
+    if (g_rate_limit_trust_proxy) {
+        std::string fwd = req.get_header_value("X-Forwarded-For");
+        fwd = fwd.substr(0, fwd.find(','));
+        fwd.erase(0, fwd.find_first_not_of(' '));
+        fwd.erase(fwd.find_last_not_of(' ') + 1);
+        if (!fwd.empty()) return fwd;
+    }
+    return req.remote_addr;
+}
+
+// Charges a /solve (or /hint) to its client. Portfolio solves occupy one core per
+// strategy and cost accordingly. Sets the RateLimit-* headers; on refusal
+// sets 429 and returns false.
+static bool admit_solve(const httplib::Request& req, const SolveRequest& sr, httplib::Response& res) {
+    if (!g_rate_limiter) return true;
+
+    const double cost = solve_cost(sr.width, sr.height, sr.piece_ids.size()) * std::max(1, sr.portfolio_threads);
+    const RateDecision d = g_rate_limiter->acquire(client_id(req), cost);
+
+    res.set_header("Access-Control-Expose-Headers", "RateLimit-Limit, RateLimit-Remaining, RateLimit-Reset, Retry-After");
+    res.set_header("RateLimit-Limit", std::to_string((long long)d.limit));
+    res.set_header("RateLimit-Remaining", std::to_string((long long)d.remaining));
+    res.set_header("RateLimit-Reset", std::to_string((long long)std::ceil(d.reset_after)));
+    if (d.allowed) return true;
+
+    res.set_header("Retry-After", std::to_string(std::max(1LL, (long long)std::ceil(d.retry_after))));
+    res.status = 429;   // body from the error handler
+    return false;
+}
+
+static SolveRequest parse_solve_request(const json& body) {
+    SolveRequest sr;
+    sr.width  = body.value("width", 0);
+    sr.height = body.value("height", 0);
+
+    if (body.contains("pieceIds") && body["pieceIds"].is_array()) {
+        for (const auto& v : body["pieceIds"]) {
+            sr.piece_ids.push_back(v.get<int>());
+        }
+    }
+
+    // "engine": a SolverRegistry name or "auto" (default)
+    if (body.contains("engine") && body["engine"].is_string()) {
+        sr.engine = body["engine"].get<std::string>();
+    }
+
+    // "limit" / "cursor": page through every solution (see solve_page)
+    if (body.contains("limit") && body["limit"].is_number_integer()) {
+        sr.limit = std::clamp(body["limit"].get<int>(), 0, kMaxPageSize);
+    }
+    if (body.contains("cursor") && body["cursor"].is_string()) {
+        sr.cursor = body["cursor"].get<std::string>();
+        if (sr.limit == 0) sr.limit = 1;
+    }
+
+    // "perf": true reports hardware counters of the search (SOLVE_PERF=1)
+    if (body.contains("perf") && body["perf"].is_boolean()) {
+        sr.perf = body["perf"].get<bool>();
+    }
+
+    // "portfolio": true (up to the cap) or a thread count
+    if (body.contains("portfolio")) {
+        const json& p = body["portfolio"];
+        int wanted = p.is_boolean() ? (p.get<bool>() ? kPortfolioStrategies : 0)
+                                    : (p.is_number_integer() ? p.get<int>() : 0);
+        sr.portfolio_threads = std::clamp(wanted, 0, portfolio_thread_cap());
+    }
+    return sr;
+}
+
+static HintRequest parse_hint_request(const json& body) {
+    HintRequest hr;
+    SolveRequest sr = parse_solve_request(body);
+    hr.width = sr.width;
+    hr.height = sr.height;
+    hr.piece_ids = std::move(sr.piece_ids);
+
+    if (body.contains("placed") && body["placed"].is_array()) {
+        for (const auto& pj : body["placed"]) {
+            HintPiece hp;
+            hp.pieceId = pj.value("pieceId", -1);
+            if (pj.contains("cells") && pj["cells"].is_array()) {
+                for (const auto& c : pj["cells"]) {
+                    hp.cells.push_back(CellDTO{c.value("x", 0), c.value("y", 0)});
+                }
+            }
+            hr.placed.push_back(std::move(hp));
+        }
+    }
+    return hr;
+}
+
+static json to_json(const HintResult& r) {
+    json j;
+    j["status"] = to_string(r.status);
+    j["error"] = r.error_message;
+    j["source"] = to_string(r.source);
+    j["nodes"] = r.nodes;
 
+    if (r.status == HintStatus::Next) {
         json cells = json::array();
-        for (const auto& c : p.cells) {
+        for (const auto& c : r.next.cells) {
             cells.push_back({{"x", c.x}, {"y", c.y}});
         }
-        pj["cells"] = std::move(cells);
-
-        placements.push_back(std::move(pj));
+        j["next"] = {
+            {"pieceId", r.next.pieceId},
+            {"variantIndex", r.next.variantIndex},
+            {"cells", std::move(cells)}
+        };
+    } else {
+        j["next"] = nullptr;
     }
-    j["placements"] = std::move(placements);
     return j;
 }
 
-int main() {
+static constexpr uint64_t kMaxTraceEvents = 1000000;
+
+// pieceId -> list of variants (normalized cells), so a client can turn
+// (pieceId, variantIndex, x, y) trace events into board cells.
+static json variants_json(const std::vector<int>& piece_ids) {
+    auto pieces = piece_ids.empty() ? PieceLibrary::make_all_pieces()
+                                    : PieceLibrary::get_piece_by_id(piece_ids);
+    json out = json::object();
+    for (const auto& p : pieces) {
+        const std::string key = std::to_string(p.get_id());
+        if (out.contains(key)) continue;
+
+        json variants = json::array();
+        for (const auto& v : p.get_variants()) {
+            json cells = json::array();
+            for (const auto& c : v) cells.push_back({c.x, c.y});
+            variants.push_back(std::move(cells));
+        }
+        out[key] = std::move(variants);
+    }
+    return out;
+}
+
+// One server process: everything below runs in each of `workers` prefork
+// workers.
+static int serve(int workers) {
     httplib::Server svr;
 
-    std::cerr << "[BOOT] before load_all_levels\n";
-    load_all_levels();
-    std::cerr << "[BOOT] after load_all_levels\n";
+    open_level_pack();
+    open_solution_db();
+    open_level_analysis();
+    open_rate_limiter(workers);
+    open_slow_request_log();
+
+    LevelWatcher watcher(g_catalog);
+    if (!g_pack) {
+        std::cerr << "[BOOT] before load_all_levels\n";
+        g_catalog.load_all();
+        std::cerr << "[BOOT] after load_all_levels\n";
+
+        g_catalog.on_reload([](uint64_t) { g_hints.clear(); });
+        if (hot_reload_enabled()) {
+            watcher.start();
+        }
+    }
 
     svr.set_error_handler([](const httplib::Request& req, httplib::Response& res) {
         add_cors(res);
@@ -184,7 +581,26 @@ int main() {
         res.status = 200;
     });
 
-    svr.Get("/pieces", [](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/stats", [](const httplib::Request&, httplib::Response& res) {
+        add_cors(res);
+
+        const CoalescerStats st = g_solve_flights.get_stats();
+        json out;
+        out["solve"] = {
+            {"leaders", st.leaders},
+            {"coalesced", st.coalesced},
+            {"takeovers", st.takeovers},
+            {"inFlight", st.in_flight},
+            {"waiting", st.waiting},
+        };
+        if (prefork_worker_index() >= 0) {
+            out["worker"] = {{"index", prefork_worker_index()}, {"pid", (long long)getpid()}};
+        }
+        res.set_content(out.dump(), "application/json; charset=utf-8");
+        res.status = 200;
+    });
+
+    svr.Get("/pieces", [](const httplib::Request& req, httplib::Response& res) {
         add_cors(res);
 
         json out;
@@ -205,37 +621,16 @@ int main() {
             out["pieces"].push_back(std::move(pj));
         }
 
-        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        send_json(req, res, out);
         res.status = 200;
     });
 
-    svr.Get("/groups", [](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/groups", [](const httplib::Request& req, httplib::Response& res) {
         add_cors(res);
 
-        json out;
-        out["groups"] = json::array();
-
-        for (const auto& g : g_groups) {
-            json gj;
-            gj["groupId"] = g.id;
-            gj["name"] = g.name;
-
-            json levels = json::array();
-            for (const auto& lv : g.levels) {
-                levels.push_back({
-                    {"id", lv.id},
-                    {"name", lv.name},
-                    {"width", lv.width},
-                    {"height", lv.height},
-                    {"pieceIds", lv.pieceIds}
-                });
-            }
-            gj["levels"] = std::move(levels);
-
-            out["groups"].push_back(std::move(gj));
-        }
+        json out = g_pack ? groups_json(*g_pack) : groups_json(*g_catalog.snapshot());
 
-        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        send_json(req, res, out);
         res.status = 200;
     });
 
@@ -245,22 +640,161 @@ int main() {
         add_cors(res);
 
         try {
-            json body = json::parse(req.body);
-
+            RequestTimer timer;
+            json body;
             SolveRequest sr;
-            sr.width  = body.value("width", 0);
-            sr.height = body.value("height", 0);
+            {
+                ScopedSpan span(&timer, "parse");
+                body = json::parse(req.body);
+                sr = parse_solve_request(body);
+            }
+            if (!admit_solve(req, sr, res)) return;
 
-            if (body.contains("pieceIds") && body["pieceIds"].is_array()) {
-                for (const auto& v : body["pieceIds"]) {
-                    sr.piece_ids.push_back(v.get<int>());
+            // "cells": "index" sends each cell as y * width + x instead of {x, y}
+            const int index_width = body.contains("cells") && body["cells"] == "index" ? sr.width : 0;
+
+            // paged: resumes its own search, so neither the pack nor a shared flight answers it
+            if (sr.limit > 0) {
+                SolvePage page;
+                {
+                    ScopedSpan span(&timer, "page");
+                    page = solve_page(sr);
+                }
+                {
+                    ScopedSpan span(&timer, "serialize");
+                    send_json(req, res, to_json(page, index_width));
                 }
+                res.status = 200;
+                res.set_header("Timing-Allow-Origin", "*");
+                res.set_header("Server-Timing", timer.server_timing());
+                SolveResult summary;
+                summary.solved = !page.solutions.empty();
+                log_if_slow(req, sr, summary, timer);
+                return;
+            }
+
+            const bool perf_refused = sr.perf && !solve_perf_enabled();
+            if (perf_refused) sr.perf = false;
+
+            SolveResult result;
+            bool from_pack = false;
+            if (sr.perf) {
+                // counts this request's own search: no pack answer, no shared flight
+                result = solve_puzzle(sr, &timer);
+            } else {
+                ScopedSpan span(&timer, "pack");
+                from_pack = solve_from_pack(sr, result);
+            }
+            if (!from_pack && !sr.perf) {
+                // a coalesced request reports its wait instead of the leader's phases
+                bool coalesced = false;
+                const uint64_t waited_from = SpanClock::now();
+                sr.should_stop = req.is_connection_closed;  // client gone: stop, a waiter takes over
+                result = g_solve_flights.solve(sr, [&](const SolveRequest& r) { return solve_puzzle(r, &timer); },
+                                               &coalesced);
+                if (coalesced) timer.add("coalesced", waited_from);
+            }
+            if (perf_refused) {
+                result.perf = true;
+                result.perf_error = "perf counters are disabled on this server (SOLVE_PERF=1)";
+            }
+
+            {
+                ScopedSpan span(&timer, "serialize");
+                send_json(req, res, to_json(result, index_width));
+            }
+            res.status = 200;
+            res.set_header("Timing-Allow-Origin", "*");
+            res.set_header("Server-Timing", timer.server_timing());
+            log_if_slow(req, sr, result, timer);
+
+        } catch (const SolveCancelled&) {
+            // the client closed the connection; nobody reads a response
+            res.status = 499;
+        } catch (const std::exception& e) {
+            json err;
+            err["solved"] = false;
+            err["error"] = std::string("Bad request: ") + e.what();
+            err["placements"] = json::array();
+
+            res.set_content(err.dump(), "application/json; charset=utf-8");
+            res.status = 400;
+        }
+    });
+
+    // "What goes next?" for a partially filled board: width, height, pieceIds
+    // as for /solve plus placed = [{pieceId, cells: [{x, y}]}].
+    svr.Post("/hint", [](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            json body = json::parse(req.body);
+            HintRequest hr = parse_hint_request(body);
+
+            // a hint can enumerate the level's solutions, so it pays like a solve
+            SolveRequest cost;
+            cost.width = hr.width;
+            cost.height = hr.height;
+            cost.piece_ids = hr.piece_ids;
+            if (!admit_solve(req, cost, res)) return;
+
+            HintResult result = g_hints.hint(hr);
+
+            res.set_content(to_json(result).dump(), "application/json; charset=utf-8");
+            res.status = result.status == HintStatus::Invalid ? 400 : 200;
+
+        } catch (const std::exception& e) {
+            json err;
+            err["status"] = to_string(HintStatus::Invalid);
+            err["error"] = std::string("Bad request: ") + e.what();
+            err["next"] = nullptr;
+
+            res.set_content(err.dump(), "application/json; charset=utf-8");
+            res.status = 400;
+        }
+    });
+
+    // Step-by-step replay (T9.1): the generic solver's place/remove events.
+    // JSON by default; Accept: application/octet-stream returns the binary
+    // trace file format (see search_trace.h).
+    svr.Post("/solve/trace", [](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            json body = json::parse(req.body);
+            SolveRequest sr = parse_solve_request(body);
+            if (!admit_solve(req, sr, res)) return;
+
+            TraceOptions options;
+            options.sample_every = std::max(1, body.value("sample", 1));
+            // 0 would mean "no cap" to the recorder; a client always gets one
+            options.max_events = std::clamp<uint64_t>(body.value("maxEvents", options.max_events), 1, kMaxTraceEvents);
+
+            SolveTrace trace = solve_puzzle_traced(sr, options);
+
+            if (req.get_header_value("Accept").find("application/octet-stream") != std::string::npos) {
+                res.set_header("X-Trace-Solved", trace.result.solved ? "true" : "false");
+                res.set_content(encode_trace(sr.width, sr.height, trace.events), "application/octet-stream");
+                res.status = 200;
+                return;
             }
 
-            SolveResult result = solve_puzzle(sr);
+            json out = to_json(trace.result);
+            out["width"] = sr.width;
+            out["height"] = sr.height;
+            out["variants"] = variants_json(sr.piece_ids);
 
-            json out = to_json(result);
-            res.set_content(out.dump(2), "application/json; charset=utf-8");
+            // [kind, pieceId, variantIndex, x, y]; kind 1 = place, 2 = remove, 3 = solved
+            json events = json::array();
+            for (const auto& ev : trace.events) {
+                events.push_back({ev.kind, ev.piece_id, ev.variant_index, ev.x, ev.y});
+            }
+            out["events"] = std::move(events);
+            out["seen"] = trace.seen;
+            out["dropped"] = trace.dropped;
+            out["truncated"] = trace.truncated;
+
+            res.set_content(out.dump(), "application/json; charset=utf-8");
             res.status = 200;
 
         } catch (const std::exception& e) {
@@ -269,7 +803,7 @@ int main() {
             err["error"] = std::string("Bad request: ") + e.what();
             err["placements"] = json::array();
 
-            res.set_content(err.dump(2), "application/json; charset=utf-8");
+            res.set_content(err.dump(), "application/json; charset=utf-8");
             res.status = 400;
         }
     });
@@ -278,8 +812,84 @@ int main() {
     std::cout << "Server listening on port " << port << "\n";
     std::cout << "GET  /\n";
     std::cout << "GET  /health\n";
+    std::cout << "GET  /stats\n";
     std::cout << "POST /solve\n";
+    std::cout << "POST /solve/trace\n";
+    std::cout << "POST /hint\n";
 
-    svr.listen("0.0.0.0", port);
+    if (!svr.listen("0.0.0.0", port)) {
+        std::cerr << "[BOOT] could not listen on port " << port << "\n";
+        return 1;
+    }
     return 0;
 }
+
+// WORKERS=N (or "auto": one per core) runs N prefork workers instead of one
+// process; unset, 0 or 1 keeps the single process.
+static int worker_count() {
+    const char* p = std::getenv("WORKERS");
+    if (!p) return 1;
+    if (std::string(p) == "auto") return (int)std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1, std::atoi(p));
+}
+
+// Compiles LEVEL_DIR into a pack the workers map (shared page cache) and
+// points LEVEL_PACK at it. mkstemp creates the file (O_EXCL, mode 0600), so
+// a link planted in the temp directory is never followed. On Linux it is
+// unlinked right away and the workers, which inherit the descriptor, map it
+// through /proc/self/fd: nothing is left behind, even after a SIGKILL.
+// Returns the file to delete on exit ("" on Linux), or "" when LEVEL_PACK
+// was given or the pack could not be written (workers then load LEVEL_DIR
+// themselves).
+static std::string prepare_shared_pack() {
+    if (std::getenv("LEVEL_PACK")) return "";
+    std::string path = (fs::temp_directory_path() / "puzzle-levels-XXXXXX").string();
+    int fd = -1;
+    try {
+        auto groups = levelpack::read_level_dir(level_root(), [](const std::string& file, const std::exception& e) {
+            std::cerr << "[PACK] " << file << " [LOAD FAIL] " << e.what() << "\n";
+        });
+        const std::vector<char> body = levelpack::encode_pack(groups, false);
+        fd = mkstemp(path.data());
+        if (fd < 0) throw std::runtime_error("Could not create " + path + ": " + std::strerror(errno));
+        for (size_t done = 0; done < body.size();) {
+            const ssize_t n = ::write(fd, body.data() + done, body.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) throw std::runtime_error("Short write to level pack: " + path);
+            done += (size_t)n;
+        }
+    } catch (const std::exception& e) {
+        if (fd >= 0) {
+            ::close(fd);
+            ::unlink(path.c_str());
+        }
+        std::cerr << "[PACK] " << e.what() << ", workers load LEVEL_DIR\n";
+        return "";
+    }
+#ifdef __linux__
+    ::unlink(path.c_str());
+    const std::string inherited = "/proc/self/fd/" + std::to_string(fd);
+    setenv("LEVEL_PACK", inherited.c_str(), 1);
+    return "";
+#else
+    ::close(fd);
+    setenv("LEVEL_PACK", path.c_str(), 1);
+    return path;
+#endif
+}
+
+int main() {
+    const int workers = worker_count();
+    if (workers <= 1) return serve(1);
+
+    // before any thread exists: the supervisor only forks and waits
+    const std::string shared_pack = prepare_shared_pack();
+    if (std::getenv("LEVEL_PACK") && hot_reload_enabled()) {
+        std::cerr << "[PREFORK] workers serve the level pack: hot reload is off, restart to pick up level changes\n";
+    }
+    PreforkOptions options;
+    options.workers = workers;
+    const int status = run_prefork(options, [workers](int) { return serve(workers); });
+    if (!shared_pack.empty()) fs::remove(shared_pack);
+    return status;
+}
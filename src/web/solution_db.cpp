@@ -0,0 +1,339 @@
+#include "solution_db.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../engine/iterative_solver.h"
+#include "level_pack.h"
+
+namespace solutiondb {
+
+SourceLevel enumerate_level(int width, int height, const std::vector<Piece>& pieces, uint64_t limit) {
+    IterativeSolver solver(width, height, pieces);
+    if (solver.get_table().largest_bucket() > 256) {
+        throw std::invalid_argument("Placement bucket does not fit a one-byte decision");
+    }
+
+    SourceLevel out;
+    out.width = width;
+    out.height = height;
+    for (const auto& p : pieces) out.piece_ids.push_back(p.get_id());
+
+    std::vector<std::vector<uint8_t>> records;
+    SearchStatus status;
+    while ((status = solver.next()) == SearchStatus::Found) {
+        const auto decisions = solver.get_decisions();
+        records.emplace_back(decisions.begin(), decisions.end());
+        if (limit > 0 && records.size() >= limit) break;
+    }
+    out.complete = status == SearchStatus::Exhausted;
+
+    // the search already emits them in this order; sort anyway, queries rely on it
+    std::sort(records.begin(), records.end());
+
+    out.solution_count = records.size();
+    out.decisions.reserve(records.size() * pieces.size());
+    for (const auto& r : records) out.decisions.insert(out.decisions.end(), r.begin(), r.end());
+    return out;
+}
+
+template <typename T>
+static void append(std::vector<char>& buf, const T& value) {
+    const char* p = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+static void align8(std::vector<char>& buf) {
+    while (buf.size() % 8) buf.push_back(0);
+}
+
+void write_db(const std::string& filename, const std::vector<SourceLevel>& levels) {
+    std::vector<DbLevel> table;
+    std::vector<uint8_t> piece_ids;
+    std::vector<const SourceLevel*> sources;
+
+    for (const auto& lv : levels) {
+        const uint64_t key = levelpack::instance_key(lv.width, lv.height, lv.piece_ids);
+
+        // the catalogue repeats some instances across groups
+        auto sorted = lv.piece_ids;
+        std::sort(sorted.begin(), sorted.end());
+        const bool duplicate = std::any_of(sources.begin(), sources.end(), [&](const SourceLevel* s) {
+            auto ids = s->piece_ids;
+            std::sort(ids.begin(), ids.end());
+            return s->width == lv.width && s->height == lv.height && ids == sorted;
+        });
+        if (duplicate) continue;
+
+        DbLevel dl{};
+        dl.key = key;
+        dl.width = (uint16_t)lv.width;
+        dl.height = (uint16_t)lv.height;
+        dl.piece_count = (uint16_t)lv.piece_ids.size();
+        dl.flags = lv.complete ? kLevelComplete : 0;
+        dl.piece_offset = (uint32_t)piece_ids.size();
+        dl.solution_count = lv.solution_count;
+        for (int id : lv.piece_ids) piece_ids.push_back((uint8_t)id);
+
+        table.push_back(dl);
+        sources.push_back(&lv);
+    }
+
+    // records in table order, then sort the table by key
+    uint64_t decision_bytes = 0;
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i].decision_offset = decision_bytes;
+        decision_bytes += sources[i]->decisions.size();
+    }
+    std::vector<size_t> order(table.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return table[a].key < table[b].key; });
+
+    DbHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.level_count = (uint32_t)table.size();
+
+    std::vector<char> body;
+    append(body, header);   // patched below once offsets are known
+
+    header.levels_offset = body.size();
+    for (size_t i : order) append(body, table[i]);
+    header.piece_ids_offset = body.size();
+    body.insert(body.end(), piece_ids.begin(), piece_ids.end());
+    align8(body);
+    header.decisions_offset = body.size();
+    for (const SourceLevel* s : sources) body.insert(body.end(), s->decisions.begin(), s->decisions.end());
+    header.file_size = body.size();
+
+    std::memcpy(body.data(), &header, sizeof(header));
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Could not write solution db: " + filename);
+    }
+    out.write(body.data(), (std::streamsize)body.size());
+    if (!out) {
+        throw std::runtime_error("Short write to solution db: " + filename);
+    }
+}
+
+}  // namespace solutiondb
+
+using namespace solutiondb;
+
+std::unique_ptr<SolutionDb> SolutionDb::open(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open solution db: " + filename);
+    }
+    std::unique_ptr<SolutionDb> db(new SolutionDb());
+    db->bytes.assign(std::istreambuf_iterator<char>(in), {});
+
+    if (db->bytes.size() < sizeof(DbHeader)) {
+        throw std::runtime_error("Solution db too small: " + filename);
+    }
+    const DbHeader& h = db->header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a solution db: " + filename);
+    }
+    if (h.version != kVersion) {
+        throw std::runtime_error("Unsupported solution db version " + std::to_string(h.version));
+    }
+    if (h.file_size != db->bytes.size() || h.levels_offset < sizeof(DbHeader) ||
+        h.levels_offset % alignof(DbLevel) ||
+        !levelpack::fits(h.levels_offset, h.level_count, sizeof(DbLevel), h.piece_ids_offset) ||
+        h.piece_ids_offset > h.decisions_offset || h.decisions_offset > h.file_size) {
+        throw std::runtime_error("Truncated solution db: " + filename);
+    }
+    const uint64_t piece_bytes = h.decisions_offset - h.piece_ids_offset;
+    const uint64_t decision_bytes = h.file_size - h.decisions_offset;
+    for (uint32_t i = 0; i < h.level_count; ++i) {
+        const DbLevel& lv = db->level(i);
+        if (lv.piece_count == 0 || !levelpack::fits(lv.piece_offset, lv.piece_count, 1, piece_bytes) ||
+            !levelpack::fits(lv.decision_offset, lv.solution_count, lv.piece_count, decision_bytes)) {
+            throw std::runtime_error("Truncated solution db: " + filename);
+        }
+    }
+    return db;
+}
+
+const DbHeader& SolutionDb::header() const {
+    return *at<DbHeader>(0);
+}
+
+const DbLevel& SolutionDb::level(uint32_t index) const {
+    return at<DbLevel>(header().levels_offset)[index];
+}
+
+const DbLevel* SolutionDb::find_level(int width, int height, const std::vector<int>& ids) const {
+    const uint64_t key = levelpack::instance_key(width, height, ids);
+    const DbLevel* first = at<DbLevel>(header().levels_offset);
+    const DbLevel* last = first + header().level_count;
+
+    auto it = std::lower_bound(first, last, key, [](const DbLevel& e, uint64_t k) { return e.key < k; });
+
+    std::vector<int> wanted(ids);
+    std::sort(wanted.begin(), wanted.end());
+
+    // verify, since different instances may share a hash
+    for (; it != last && it->key == key; ++it) {
+        if (it->width != width || it->height != height) continue;
+        std::vector<int> have = piece_ids(*it);
+        std::sort(have.begin(), have.end());
+        if (have == wanted) return &*it;
+    }
+    return nullptr;
+}
+
+std::vector<int> SolutionDb::piece_ids(const DbLevel& lv) const {
+    const uint8_t* p = at<uint8_t>(header().piece_ids_offset + lv.piece_offset);
+    return std::vector<int>(p, p + lv.piece_count);
+}
+
+std::span<const uint8_t> SolutionDb::solution(const DbLevel& lv, uint64_t index) const {
+    return {at<uint8_t>(header().decisions_offset + lv.decision_offset) + index * lv.piece_count, lv.piece_count};
+}
+
+// Placement `d` at the first empty cell of `occupied`, or throws when the
+// record does not fit this table (a corrupt file, or one built with another
+// table order).
+static uint32_t checked_decision(const PlacementTable& table, uint64_t occupied, uint8_t d) {
+    const int cell = PlacementTable::first_empty(occupied);
+    if (cell >= table.cell_count()) {
+        throw std::runtime_error("Corrupt solution db record");
+    }
+    const uint32_t k = table.bucket_begin(cell) + d;
+    if (k >= table.bucket_end(cell) || (table.at(k).mask & occupied)) {
+        throw std::runtime_error("Corrupt solution db record");
+    }
+    return k;
+}
+
+std::vector<Placement> SolutionDb::decode(const DbLevel& lv, const PlacementTable& table, uint64_t index) const {
+    std::vector<Placement> out;
+    uint64_t occupied = 0;
+    for (uint8_t d : solution(lv, index)) {
+        const uint32_t k = checked_decision(table, occupied, d);
+        out.push_back(table.to_placement(k));
+        occupied |= table.at(k).mask;
+    }
+    if (occupied != table.full_mask()) {
+        throw std::runtime_error("Corrupt solution db record");
+    }
+    return out;
+}
+
+namespace {
+
+// The records of [lo, hi) share their first `depth` bytes, so byte `depth`
+// is sorted inside the range.
+class Column {
+public:
+    const uint8_t* base;
+    size_t stride;
+    size_t depth;
+
+    uint8_t at(uint64_t i) const { return base[i * stride + depth]; }
+
+    uint64_t lower(uint64_t lo, uint64_t hi, uint8_t value) const {
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (at(mid) < value) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+    uint64_t upper(uint64_t lo, uint64_t hi, uint8_t value) const {
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (at(mid) <= value) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+};
+
+class ConsistentWalk {
+public:
+    const uint8_t* base;
+    size_t stride;
+    const PlacementTable& table;
+    const std::vector<PlacedPiece>& placed;
+    uint64_t placed_mask;
+    size_t limit;
+    std::vector<uint64_t>& out;
+
+    bool full() const { return limit > 0 && out.size() >= limit; }
+
+    void walk(size_t depth, uint64_t lo, uint64_t hi, uint64_t occupied) {
+        if (lo >= hi || full()) return;
+        if (depth == stride) {
+            if (occupied != table.full_mask()) {
+                throw std::runtime_error("Corrupt solution db record");
+            }
+            for (uint64_t i = lo; i < hi && !full(); ++i) out.push_back(i);
+            return;
+        }
+
+        const Column col{base, stride, depth};
+        const int cell = PlacementTable::first_empty(occupied);
+        if (cell >= table.cell_count()) {
+            throw std::runtime_error("Corrupt solution db record");
+        }
+        const uint32_t b = table.bucket_begin(cell);
+        const uint32_t e = table.bucket_end(cell);
+
+        // a placed piece covers this cell: its decision is forced
+        for (const auto& p : placed) {
+            if (!(p.mask >> cell & 1)) continue;
+            for (uint32_t k = b; k < e; ++k) {
+                const TablePlacement& tp = table.at(k);
+                if (tp.mask != p.mask ||
+                    table.get_inventory().get_kinds()[tp.kind_index].piece->get_id() != p.piece_id) continue;
+
+                const uint8_t d = (uint8_t)(k - b);
+                const uint64_t first = col.lower(lo, hi, d);
+                walk(depth + 1, first, col.upper(first, hi, d), occupied | tp.mask);
+            }
+            return;
+        }
+
+        // free cell: one branch per distinct decision, skipping any that
+        // would cover a placed piece's cells
+        for (uint64_t i = lo; i < hi && !full();) {
+            const uint8_t d = col.at(i);
+            const uint64_t next = col.upper(i, hi, d);
+            const uint64_t mask = table.at(checked_decision(table, occupied, d)).mask;
+            if (!(mask & placed_mask)) walk(depth + 1, i, next, occupied | mask);
+            i = next;
+        }
+    }
+};
+
+}  // namespace
+
+std::pair<uint64_t, uint64_t> SolutionDb::prefix_range(const DbLevel& lv, std::span<const uint8_t> prefix) const {
+    const uint8_t* base = at<uint8_t>(header().decisions_offset + lv.decision_offset);
+    uint64_t lo = 0, hi = lv.solution_count;
+    for (size_t depth = 0; depth < prefix.size() && depth < lv.piece_count && lo < hi; ++depth) {
+        const Column col{base, lv.piece_count, depth};
+        lo = col.lower(lo, hi, prefix[depth]);
+        hi = col.upper(lo, hi, prefix[depth]);
+    }
+    if (prefix.size() > lv.piece_count) hi = lo;
+    return {lo, hi};
+}
+
+std::vector<uint64_t> SolutionDb::consistent(const DbLevel& lv, const PlacementTable& table,
+                                             const std::vector<PlacedPiece>& placed, size_t limit) const {
+    uint64_t placed_mask = 0;
+    for (const auto& p : placed) placed_mask |= p.mask;
+
+    std::vector<uint64_t> out;
+    ConsistentWalk w{at<uint8_t>(header().decisions_offset + lv.decision_offset), lv.piece_count,
+                     table, placed, placed_mask, limit, out};
+    w.walk(0, 0, lv.solution_count, 0);
+    return out;
+}
@@ -0,0 +1,132 @@
+#ifndef SOLUTION_DB_H
+#define SOLUTION_DB_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../engine/piece.h"
+#include "../engine/placement.h"
+#include "../engine/placement_table.h"
+
+// Solution database: every solution of every catalogue level.
+// --------------------------------
+// A solution is stored as its decisions: one byte per depth, the index of the
+// chosen placement inside the PlacementTable bucket of the first empty cell
+// (buckets hold at most 12 kinds x 8 variants, so a byte is enough). A level
+// with N pieces takes N bytes per solution.
+//
+// A level's solutions are sorted lexicographically, so solutions that share a
+// search prefix are adjacent: a prefix is one binary search, and a set of
+// placed pieces is a walk down that implicit trie (see SolutionDb::consistent).
+// Sorted fixed-width records also compress well if the file is shipped
+// gzipped.
+//
+// File layout (little endian, offsets from the file start):
+//   DbHeader
+//   DbLevel[level_count]     sorted by key
+//   uint8 piece_ids[]        per level, in the order the table was built from
+//   uint8 decisions[]        per level, solution_count * piece_count bytes
+namespace solutiondb {
+
+constexpr char kMagic[8] = {'P', 'Z', 'S', 'O', 'L', 'D', 'B', '\0'};
+constexpr uint32_t kVersion = 1;
+
+constexpr uint16_t kLevelComplete = 1u << 0;    // every solution is stored
+
+struct DbHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t level_count;
+    uint64_t levels_offset;
+    uint64_t piece_ids_offset;
+    uint64_t decisions_offset;
+    uint64_t file_size;
+};
+
+struct DbLevel {
+    uint64_t key;               // levelpack::instance_key
+    uint16_t width;
+    uint16_t height;
+    uint16_t piece_count;
+    uint16_t flags;
+    uint32_t piece_offset;      // into piece_ids
+    uint32_t reserved;
+    uint64_t decision_offset;   // into decisions
+    uint64_t solution_count;
+};
+
+static_assert(sizeof(DbHeader) == 48);
+static_assert(sizeof(DbLevel) == 40);
+
+// ----- writer side (solutiondb tool) -----
+
+struct SourceLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<int> piece_ids;         // table order
+    std::vector<uint8_t> decisions;     // sorted records
+    uint64_t solution_count = 0;
+    bool complete = false;
+};
+
+// Enumerate the solutions of one level (limit > 0 stops after that many) and
+// sort them. Throws std::invalid_argument for boards over 64 cells.
+SourceLevel enumerate_level(int width, int height, const std::vector<Piece>& pieces, uint64_t limit = 0);
+
+// Duplicate instances are stored once. Throws std::runtime_error on I/O failure.
+void write_db(const std::string& filename, const std::vector<SourceLevel>& levels);
+
+}  // namespace solutiondb
+
+// A piece already on the board, for SolutionDb::consistent.
+class PlacedPiece {
+public:
+    int piece_id = -1;
+    uint64_t mask = 0;
+};
+
+class SolutionDb {
+public:
+    // Throws std::runtime_error when the file is missing or malformed.
+    static std::unique_ptr<SolutionDb> open(const std::string& filename);
+
+    uint32_t level_count() const { return header().level_count; }
+    const solutiondb::DbLevel& level(uint32_t index) const;
+
+    // Lookup by board size and piece multiset; nullptr if absent.
+    const solutiondb::DbLevel* find_level(int width, int height, const std::vector<int>& piece_ids) const;
+
+    // Piece ids in table order. Decoding needs a PlacementTable built from
+    // exactly these pieces (keep the vector alive, the table points into it).
+    std::vector<int> piece_ids(const solutiondb::DbLevel& lv) const;
+
+    std::span<const uint8_t> solution(const solutiondb::DbLevel& lv, uint64_t index) const;
+
+    // decode() and consistent() replay records on `table` and throw
+    // std::runtime_error for one that does not fit it (out-of-range or
+    // overlapping decisions, or a board left unfilled).
+    std::vector<Placement> decode(const solutiondb::DbLevel& lv, const PlacementTable& table, uint64_t index) const;
+
+    // [first, last) of the solutions whose decisions start with `prefix`.
+    std::pair<uint64_t, uint64_t> prefix_range(const solutiondb::DbLevel& lv, std::span<const uint8_t> prefix) const;
+
+    // Indices of the solutions containing every placed piece (placed pieces
+    // must not overlap), in sorted order; limit > 0 stops after that many.
+    std::vector<uint64_t> consistent(const solutiondb::DbLevel& lv, const PlacementTable& table,
+                                     const std::vector<PlacedPiece>& placed, size_t limit = 0) const;
+
+private:
+    SolutionDb() = default;
+    const solutiondb::DbHeader& header() const;
+
+    template <typename T>
+    const T* at(uint64_t offset) const { return reinterpret_cast<const T*>(bytes.data() + offset); }
+
+    std::vector<char> bytes;
+};
+
+#endif
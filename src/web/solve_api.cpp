@@ -2,8 +2,19 @@
 #include "../engine/piece_library.h"
 #include "../engine/board.h"
 #include "../engine/solver.h"
+#include "../engine/iterative_solver.h"
+#include "../engine/feasibility.h"
+#include "../engine/placement_table.h"
+#include "../engine/portfolio_solver.h"
+#include "../engine/solver_strategy.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 static int count_cells(const std::vector<Piece>& pieces) {
@@ -24,18 +35,15 @@ static const Piece* find_piece_by_id(const std::vector<Piece>& pieces, int id) {
     return nullptr;
 }
 
-SolveResult solve_puzzle(const SolveRequest& req) {
-    SolveResult out;
-
+bool prepare_pieces(const SolveRequest& req, std::vector<Piece>& pieces, SolveResult& out) {
     // basic check
     if(req.width <= 0 || req.height <= 0) {
         out.solved = false; 
         out.error_message = "Invalid board size.";
-        return out;
+        return false;
     }
 
     // Load pieces (get pieces fomr library)
-    std::vector<Piece> pieces;
     try {
         if (req.piece_ids.empty()) {
             pieces = PieceLibrary::make_all_pieces();
@@ -45,7 +53,7 @@ SolveResult solve_puzzle(const SolveRequest& req) {
     } catch (const std::exception& e) {
         out.solved = false;
         out.error_message = e.what();
-        return out;
+        return false;
     }
 
     // Area check 【 如果 board 面積不等於 pieces 加總的面積就無解 】
@@ -56,22 +64,217 @@ SolveResult solve_puzzle(const SolveRequest& req) {
         out.solved = false;
         out.error_message = "Area mismatch: board = " + std::to_string(board_area) +
                             " pieces = " + std::to_string(pieces_area);
+        return false;
+    }
+
+    // Pre-solve analysis: reject what cannot be solved before searching
+    FeasibilityReport feasibility = check_feasibility(req.width, req.height, pieces);
+    if (!feasibility.feasible) {
+        out.solved = false;
+        out.error_message = feasibility.reason;
+        return false;
+    }
+    return true;
+}
+
+static void throw_if_stopped(const SolveRequest& req) {
+    if (req.should_stop && req.should_stop()) throw SolveCancelled();
+}
+
+SolveResult solve_puzzle(const SolveRequest& req, RequestTimer* timer) {
+    SolveResult out;
+
+    std::vector<Piece> pieces;
+    {
+        ScopedSpan span(timer, "prepare");
+        if (!prepare_pieces(req, pieces, out)) {
+            return out;
+        }
+    }
+    throw_if_stopped(req);
+
+    // Per-request race of search orders, for the slow tail of hard levels
+    if (req.portfolio_threads > 0 && PlacementTable::supports(req.width, req.height)) {
+        PortfolioOptions options;
+        options.threads = req.portfolio_threads;
+        options.should_stop = req.should_stop;
+        PortfolioResult r;
+        {
+            ScopedSpan span(timer, "search");
+            r = solve_portfolio(req.width, req.height, pieces, options);
+        }
+        throw_if_stopped(req);
+        if (r.solved) {
+            ScopedSpan span(timer, "dto");
+            out = make_solve_result(pieces, r.path);
+        }
+        out.strategy = to_string(r.winner);
+        out.engine = "portfolio";
+        if (req.perf) {
+            out.perf = true;
+            out.perf_error = "portfolio searches on other threads; counters not collected";
+        }
+        return out;
+    }
+
+    // Registered engine by name, or the cheapest estimate for "auto"
+    const SolverStrategy* engine = SolverRegistry::instance().select(req.engine, req.width, req.height, pieces);
+    if (!engine) {
+        out.error_message = "Unknown engine or board size not supported by it: " + req.engine;
         return out;
     }
 
-    // Solve
+    std::vector<Placement> path;
+    if (req.perf) {
+        PerfCounters counters;      // opened outside the span: a few syscalls per event
+        out.perf = true;
+        out.perf_error = counters.reason();
+        ScopedSpan span(timer, "search");
+        counters.start();
+        out.solved = engine->solve_with_stats(req.width, req.height, pieces, path, out.perf_report.stats);
+        out.perf_report.sample = counters.stop();
+    } else {
+        ScopedSpan span(timer, "search");
+        out.solved = req.should_stop ? engine->solve_until(req.width, req.height, pieces, path, req.should_stop)
+                                     : engine->solve(req.width, req.height, pieces, path);
+    }
+    throw_if_stopped(req);
+    out.engine = engine->name();
+    if (!out.solved) {
+        return out;
+    }
+
+    ScopedSpan span(timer, "dto");
+    SolveResult solved = make_solve_result(pieces, path);
+    solved.engine = out.engine;
+    solved.perf = out.perf;
+    solved.perf_report = out.perf_report;
+    solved.perf_error = out.perf_error;
+    return solved;
+}
+
+static const char kBase64Url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// base64url without padding
+static std::string encode_cursor(const SearchCheckpoint& cp) {
+    const std::vector<uint8_t> bytes = cp.serialize();
+    std::string out;
+    out.reserve((bytes.size() * 4 + 2) / 3);
+    uint32_t acc = 0;
+    int bits = 0;
+    for (uint8_t b : bytes) {
+        acc = (acc << 8) | b;
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out += kBase64Url[(acc >> bits) & 63];
+        }
+    }
+    if (bits > 0) out += kBase64Url[(acc << (6 - bits)) & 63];
+    return out;
+}
+
+// Throws std::runtime_error on anything that is not an encoded checkpoint.
+static SearchCheckpoint decode_cursor(const std::string& cursor) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(cursor.size() * 3 / 4);
+    uint32_t acc = 0;
+    int bits = 0;
+    for (char c : cursor) {
+        const char* at = std::strchr(kBase64Url, c);
+        if (c == '\0' || !at) throw std::runtime_error("Invalid cursor");
+        acc = (acc << 6) | (uint32_t)(at - kBase64Url);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            bytes.push_back((uint8_t)(acc >> bits));
+        }
+    }
+    return SearchCheckpoint::deserialize(bytes);
+}
+
+SolvePage solve_page(const SolveRequest& req, uint64_t node_budget) {
+    SolvePage page;
+    SolveResult checked;
+    std::vector<Piece> pieces;
+    if (!prepare_pieces(req, pieces, checked)) {
+        page.error_message = checked.error_message;
+        return page;
+    }
+    if (!PlacementTable::supports(req.width, req.height)) {
+        page.error_message = "Paging needs a board of at most 64 cells";
+        return page;
+    }
+
+    IterativeSolver solver(req.width, req.height, pieces);
+    if (!req.cursor.empty()) {
+        try {
+            solver.resume(decode_cursor(req.cursor));
+        } catch (const std::exception& e) {
+            page.error_message = std::string("Invalid cursor: ") + e.what();
+            return page;
+        }
+    }
+
+    const int limit = std::clamp(req.limit, 1, kMaxPageSize);
+    const uint64_t nodes_before = solver.get_stats().nodes;
+    page.first_index = solver.get_stats().solutions;
+
+    SearchStatus status = SearchStatus::Paused;
+    while ((int)page.solutions.size() < limit) {
+        const uint64_t used = solver.get_stats().nodes - nodes_before;
+        if (node_budget > 0 && used >= node_budget) break;
+        status = solver.next(node_budget > 0 ? node_budget - used : 0);
+        if (status != SearchStatus::Found) break;
+        page.solutions.push_back(make_solve_result(pieces, solver.get_placements_path()).placements);
+    }
+
+    page.nodes = solver.get_stats().nodes - nodes_before;
+    if (status != SearchStatus::Exhausted) page.next_cursor = encode_cursor(solver.checkpoint());
+    return page;
+}
+
+SolveTrace solve_puzzle_traced(const SolveRequest& req, const TraceOptions& options) {
+    SolveTrace trace;
+
+    std::vector<Piece> pieces;
+    if (!prepare_pieces(req, pieces, trace.result)) {
+        return trace;
+    }
+
+    // always the generic Solver: its dfs is the one that records events
+    TraceRecorder recorder(options.ring_capacity, options.sample_every, options.max_events);
     Board board(req.width, req.height);
     Solver solver(board, pieces);
-    
-    out.solved = solver.solve();
+    solver.set_trace(&recorder);
 
-    if(!out.solved) {
-        return out;
-    } 
-    
-    // convert placements to DTO
+    // drain while solving so a long search does not overflow the ring
+    std::atomic<bool> done{false};
+    std::thread drainer([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            if (recorder.drain(trace.events) == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    });
+
+    const bool solved = solver.solve();
+    done.store(true, std::memory_order_release);
+    drainer.join();
+    recorder.drain(trace.events);
+
+    trace.seen = recorder.seen();
+    trace.dropped = recorder.dropped();
+    trace.truncated = recorder.truncated();
+    trace.result = solved ? make_solve_result(pieces, solver.get_placements_path()) : SolveResult{};
+    return trace;
+}
 
-    const auto& path = solver.get_placements_path();
+SolveResult make_solve_result(const std::vector<Piece>& pieces, const std::vector<Placement>& path) {
+    SolveResult out;
+    out.solved = true;
+
+    // convert placements to DTO
     out.placements.reserve(path.size());
 
     for(const auto& placement : path) {
@@ -112,3 +315,6 @@ SolveResult solve_puzzle(const SolveRequest& req) {
     return out;
 }
 
+std::vector<PlacementDTO> read_stream_solution(SolutionFileReader& file, uint64_t index) {
+    return make_solve_result(file.get_pieces(), file.placements(index)).placements;
+}
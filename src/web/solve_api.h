@@ -1,14 +1,33 @@
 #ifndef SOLVE_API_H
 #define SOLVE_API_H
+#include <functional>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include "../engine/perf_counters.h"
+#include "../engine/piece.h"
 #include "../engine/placement.h"
+#include "../engine/search_trace.h"
+#include "../engine/solution_stream.h"
+#include "request_timing.h"
 
 class SolveRequest {
 public:
     int width = 0;
     int height = 0;
     std::vector<int> piece_ids; 
+    int portfolio_threads = 0;      // > 0: race that many search orders (solve_portfolio)
+    std::string engine = "auto";    // SolverRegistry name, or auto
+    int limit = 0;                  // > 0: a page of up to that many solutions (solve_page)
+    std::string cursor;             // where the previous page stopped; empty = first page
+    bool perf = false;              // debug: hardware counters around the search (solve_puzzle)
+    std::function<bool()> should_stop;  // true: the caller is gone (solve_puzzle throws SolveCancelled)
+};
+
+// solve_puzzle gave up because req.should_stop() said so.
+class SolveCancelled : public std::runtime_error {
+public:
+    SolveCancelled() : std::runtime_error("solve cancelled") {}
 };
 
 class CellDTO {
@@ -29,8 +48,70 @@ public:
     bool solved = false;
     std::vector<PlacementDTO> placements;
     std::string error_message; 
+    std::string strategy;           // portfolio winner, empty otherwise
+    std::string engine;             // engine that searched ("portfolio" for a race)
+    bool perf = false;              // req.perf: perf_report holds what could be counted
+    PerfReport perf_report;
+    std::string perf_error;         // why some or all counters are missing
+};
+
+// `timer`, when given, gets the "prepare", "search" and "dto" phases.
+// req.should_stop is polled between phases and, by the iterative engine and
+// the portfolio race, during the search; once it returns true solve_puzzle
+// throws SolveCancelled. The other engines only notice after their search.
+// req.perf counts the search of a single engine with PerfCounters, next to
+// the engine's node and placement-test counters; a portfolio race is not
+// counted (its threads are not the caller's).
+SolveResult solve_puzzle(const SolveRequest& req, RequestTimer* timer = nullptr);
+
+// Shared checks of every solve entry point (size, ids, area, feasibility).
+// Fills `pieces`, or returns false with the reason in out.error_message.
+bool prepare_pieces(const SolveRequest& req, std::vector<Piece>& pieces, SolveResult& out);
+
+constexpr int kMaxPageSize = 100;
+constexpr uint64_t kPageNodeBudget = 20000000;   // ~1-2 s of search
+
+class SolvePage {
+public:
+    std::vector<std::vector<PlacementDTO>> solutions;
+    uint64_t first_index = 0;       // search-order index of solutions[0]
+    std::string next_cursor;        // empty: the search is exhausted
+    uint64_t nodes = 0;             // placements made for this page
+    std::string error_message;
 };
 
-SolveResult solve_puzzle(const SolveRequest& req);
+// Solutions one page at a time, in IterativeSolver order (boards of at most
+// 64 cells). The cursor is the search checkpoint after the page, base64url
+// encoded, so the next page resumes by replaying its decision stack instead
+// of searching past the solutions already sent. A page stops early, with a
+// cursor, once it has placed `node_budget` pieces; it may then hold fewer
+// than req.limit solutions, even none. The cursor only resumes the request
+// it came from (same size and piece ids in the same order).
+SolvePage solve_page(const SolveRequest& req, uint64_t node_budget = kPageNodeBudget);
+
+class TraceOptions {
+public:
+    uint32_t sample_every = 1;      // keep one event in N
+    uint64_t max_events = 200000;   // 0 = no cap
+    size_t ring_capacity = 1u << 16;
+};
+
+class SolveTrace {
+public:
+    SolveResult result;
+    std::vector<TraceEvent> events;
+    uint64_t seen = 0;              // events produced by the search
+    uint64_t dropped = 0;           // lost to a full ring
+    bool truncated = false;         // max_events reached
+};
+
+// Solve with the generic Solver and record its place/remove events (T9.1).
+SolveTrace solve_puzzle_traced(const SolveRequest& req, const TraceOptions& options);
+
+// Turn a solver path into absolute-cell DTOs (pieces must contain every id in path).
+SolveResult make_solve_result(const std::vector<Piece>& pieces, const std::vector<Placement>& path);
+
+// Solution `index` of a solution stream file as DTOs (see solution_stream.h).
+std::vector<PlacementDTO> read_stream_solution(SolutionFileReader& file, uint64_t index);
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "solve_coalescer.h"
+
+#include <algorithm>
+
+std::string SolveCoalescer::instance_key(const SolveRequest& req) {
+    std::vector<int> ids = req.piece_ids;
+    std::sort(ids.begin(), ids.end());
+
+    std::string key = std::to_string(req.width) + "x" + std::to_string(req.height) + ":";
+    for (int id : ids) {
+        key += std::to_string(id);
+        key += ',';
+    }
+    // the response names the engine (and the winning strategy of a portfolio
+    // race), so requests for different ones do not share
+    return key + req.engine + "/p" + std::to_string(req.portfolio_threads);
+}
+
+SolveResult SolveCoalescer::solve(const SolveRequest& req, const SolveFn& solve_fn, bool* coalesced) {
+    const std::string key = instance_key(req);
+    bool waited = false;
+
+    for (;;) {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = flights.find(key);
+
+        if (it == flights.end()) {
+            std::promise<std::shared_ptr<const SolveResult>> promise;
+            flights.emplace(key, promise.get_future().share());
+            ++stats.leaders;
+            ++stats.in_flight;
+            if (waited) ++stats.takeovers;
+            lock.unlock();
+
+            std::shared_ptr<const SolveResult> result;
+            try {
+                result = std::make_shared<const SolveResult>(solve_fn(req));
+            } catch (const SolveCancelled&) {
+                land(key);
+                promise.set_value(nullptr);
+                throw;
+            } catch (...) {
+                land(key);
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+
+            land(key);
+            promise.set_value(result);
+
+            if (coalesced) *coalesced = false;
+            return *result;
+        }
+
+        Shared flight = it->second;
+        ++stats.waiting;
+        lock.unlock();
+
+        std::shared_ptr<const SolveResult> result;
+        try {
+            result = flight.get();
+        } catch (...) {
+            lock.lock();
+            --stats.waiting;
+            throw;
+        }
+
+        lock.lock();
+        --stats.waiting;
+        if (result) {
+            ++stats.coalesced;
+            lock.unlock();
+            if (coalesced) *coalesced = true;
+            return *result;
+        }
+        waited = true;
+    }
+}
+
+void SolveCoalescer::land(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    flights.erase(key);
+    --stats.in_flight;
+}
+
+CoalescerStats SolveCoalescer::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,59 @@
+#ifndef SOLVE_COALESCER_H
+#define SOLVE_COALESCER_H
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "solve_api.h"
+
+class CoalescerStats {
+public:
+    uint64_t leaders = 0;       // requests that ran the solver
+    uint64_t coalesced = 0;     // requests answered by another request's run
+    uint64_t takeovers = 0;     // waiters that became leader after the leader gave up
+    uint64_t in_flight = 0;     // instances being solved now
+    uint64_t waiting = 0;       // requests waiting on one of them
+};
+
+// Single-flight deduplication of identical solves.
+// --------------------------------
+// Requests are keyed on the canonical instance: width, height and the sorted
+// piece ids (any solution of the multiset answers every permutation), plus
+// the requested engine and portfolio thread count. The first request for a
+// key runs `solve`; requests for the same key arriving while it runs wait on
+// a shared future and get a copy of its result.
+//
+// When the leader's solve throws SolveCancelled (its client went away), the
+// exception goes to the leader's caller only. The flight is dropped, and the
+// first waiter to wake up starts a new one as its leader; the others join
+// it. Any other exception is the answer for the instance: every waiter
+// rethrows it too.
+class SolveCoalescer {
+public:
+    using SolveFn = std::function<SolveResult(const SolveRequest&)>;
+
+    // `coalesced`, when given, is set to whether the result came from
+    // another request's run.
+    SolveResult solve(const SolveRequest& req, const SolveFn& solve, bool* coalesced = nullptr);
+
+    CoalescerStats get_stats() const;
+
+    static std::string instance_key(const SolveRequest& req);
+
+private:
+    // nullptr: the leader was cancelled
+    using Shared = std::shared_future<std::shared_ptr<const SolveResult>>;
+
+    void land(const std::string& key);     // the leader's flight is over
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Shared> flights;
+    CoalescerStats stats;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../src/game/batch_solver.h"
+
+namespace fs = std::filesystem;
+
+static fs::path write_levels() {
+    fs::path dir = fs::temp_directory_path() / "ut_batch_solver";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "Group A");
+    std::ofstream(dir / "Group A" / "levels1.txt") << "3 5\n\n0 1 2";
+    std::ofstream(dir / "Group A" / "levels2.txt") << "3 5\n\n0 1";        // area mismatch
+    std::ofstream(dir / "Group A" / "notes.md") << "ignored";
+    return dir;
+}
+
+TEST(BatchSolverTest, SolveDirTest) {
+    fs::path dir = write_levels();
+    std::vector<std::string> files = collect_level_files(dir.string());
+    ASSERT_EQ(files.size(), 2u);
+
+    std::vector<BatchLevel> levels = solve_level_files(files, 2);
+    ASSERT_EQ(levels.size(), 2u);
+
+    const BatchLevel& a = levels[0];
+    EXPECT_EQ(a.group, "Group A");
+    EXPECT_EQ(a.level, "levels1");
+    EXPECT_TRUE(a.ok());
+    ASSERT_EQ(a.grid.size(), 15u);
+    for (int v : a.grid) EXPECT_TRUE(v == 0 || v == 1 || v == 2);
+
+    EXPECT_FALSE(levels[1].ok());
+    EXPECT_FALSE(levels[1].error.empty());
+
+    std::ostringstream csv;
+    write_batch_csv(csv, levels);
+    EXPECT_EQ(csv.str().rfind("group,level,width,height,pieces,solved,engine,ms,error,solution\n", 0), 0u);
+    EXPECT_NE(csv.str().find("Group A,levels1,3,5,3,1,"), std::string::npos);
+
+    std::ostringstream json;
+    write_batch_json(json, levels);
+    EXPECT_NE(json.str().find("\"grid\": [["), std::string::npos);
+    EXPECT_NE(json.str().find("\"error\": "), std::string::npos);
+
+    fs::remove_all(dir);
+}
+
+TEST(BatchSolverTest, MissingFileTest) {
+    BatchLevel lv = solve_level_file("/nonexistent/levels1.txt");
+    EXPECT_FALSE(lv.ok());
+    EXPECT_NE(lv.error.find("Could not open"), std::string::npos);
+    EXPECT_THROW(collect_level_files("/nonexistent"), std::runtime_error);
+}
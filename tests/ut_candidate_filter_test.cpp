@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "../src/engine/candidate_filter.h"
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/piece_library.h"
+
+// Reference: the one-candidate-at-a-time test of the bitmask engines.
+static std::vector<uint16_t> reference(const PlacementTable& table, int cell, uint64_t occupied, uint64_t exhausted) {
+    std::vector<uint16_t> out;
+    for (uint32_t k = table.bucket_begin(cell); k < table.bucket_end(cell); ++k) {
+        const TablePlacement& p = table.at(k);
+        if ((p.mask & occupied) || (exhausted >> p.kind_index & 1)) continue;
+        out.push_back((uint16_t)(k - table.bucket_begin(cell)));
+    }
+    return out;
+}
+
+TEST(CandidateFilterTest, KernelsMatchReferenceTest) {
+    std::vector<Piece> pieces = PieceLibrary::make_all_pieces();
+    PlacementTable table(10, 6, pieces);
+    std::vector<FilterKernel> kernels = {FilterKernel::Scalar};
+    if (detect_filter_kernel() == FilterKernel::Avx2) kernels.push_back(FilterKernel::Avx2);
+
+    std::mt19937_64 rng(7);
+    for (FilterKernel kernel : kernels) {
+        CandidateFilter filter(table, kernel);
+        std::vector<uint16_t> out(filter.capacity());
+        for (int round = 0; round < 2000; ++round) {
+            const int cell = (int)(rng() % table.cell_count());
+            // cells before the anchor are filled, the rest at random
+            const uint64_t occupied = ((1ull << cell) - 1) | (rng() & rng() & table.full_mask() & ~(1ull << cell));
+            const uint64_t exhausted = rng() & 0xFFF & rng();
+
+            const int n = filter.filter(cell, occupied, exhausted, out.data());
+            const auto want = reference(table, cell, occupied, exhausted);
+            ASSERT_EQ(want, std::vector<uint16_t>(out.begin(), out.begin() + n)) << to_string(kernel);
+        }
+    }
+}
+
+TEST(CandidateFilterTest, FilteredSearchMatchesIterativeTest) {
+    for (auto ids : std::vector<std::vector<int>>{{0, 6, 3, 1, 7, 11}, {6, 8, 6, 11}}) {
+        std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(ids);
+        const int w = ids.size() == 6 ? 6 : 5;
+        const int h = ids.size() == 6 ? 5 : 4;
+        PlacementTable table(w, h, pieces);
+
+        IterativeSolver iterative(w, h, pieces);
+        const uint64_t count = iterative.count_solutions();
+
+        for (FilterKernel kernel : {FilterKernel::Scalar, detect_filter_kernel()}) {
+            FilteredSearch search(table, kernel);
+            EXPECT_EQ(count, search.count_solutions());
+            EXPECT_EQ(iterative.get_stats().nodes, search.get_stats().nodes);
+        }
+    }
+}
+
+TEST(CandidateFilterTest, FirstSolutionTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1, 7, 11});
+    PlacementTable table(6, 5, pieces);
+
+    IterativeSolver iterative(6, 5, pieces);
+    ASSERT_TRUE(iterative.solve());
+    const auto want = iterative.get_placements_path();
+
+    FilteredSearch search(table);
+    ASSERT_TRUE(search.solve());
+    const auto got = search.get_placements_path();
+    ASSERT_EQ(want.size(), got.size());
+    for (size_t i = 0; i < want.size(); ++i) {
+        EXPECT_EQ(want[i].get_piece_id(), got[i].get_piece_id());
+        EXPECT_EQ(want[i].get_variant_index(), got[i].get_variant_index());
+        EXPECT_EQ(want[i].get_offset(), got[i].get_offset());
+    }
+
+    search.count_solutions();
+    EXPECT_TRUE(search.get_placements_path().empty());
+}
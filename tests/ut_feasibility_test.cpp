@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../src/engine/board.h"
+#include "../src/engine/feasibility.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solver.h"
+
+static std::vector<Piece> tetrominoes() {
+    return {
+        Piece{0, {{0, 0}, {1, 0}, {2, 0}, {3, 0}}},   // I
+        Piece{1, {{0, 0}, {1, 0}, {0, 1}, {1, 1}}},   // O
+        Piece{2, {{0, 0}, {0, 1}, {0, 2}, {1, 2}}},   // L
+        Piece{3, {{1, 0}, {2, 0}, {0, 1}, {1, 1}}},   // S
+        Piece{4, {{0, 0}, {1, 0}, {2, 0}, {1, 1}}},   // T
+    };
+}
+
+TEST(FeasibilityTest, CatalogueLevelPassesTest) {
+    auto pieces = PieceLibrary::get_piece_by_id({0, 3, 11, 10, 4});
+    FeasibilityReport report = check_feasibility(5, 5, pieces);
+    EXPECT_TRUE(report.feasible);
+    EXPECT_TRUE(report.reason.empty());
+}
+
+TEST(FeasibilityTest, PieceDoesNotFitTest) {
+    // the X piece needs a 3x3 box; the I (8) lies along the 5-cell side
+    auto pieces = PieceLibrary::get_piece_by_id({8, 9});
+    FeasibilityReport report = check_feasibility(2, 5, pieces);
+    EXPECT_FALSE(report.feasible);
+    EXPECT_EQ("Piece 9 does not fit on a 2x5 board in any orientation.", report.reason);
+}
+
+TEST(FeasibilityTest, CheckerboardParityTest) {
+    // the five tetrominoes never tile 4x5: T covers 3+1, the rest 2+2
+    auto pieces = tetrominoes();
+    FeasibilityReport report = check_feasibility(4, 5, pieces);
+    EXPECT_FALSE(report.feasible);
+    EXPECT_NE(std::string::npos, report.reason.find("Checkerboard parity"));
+
+    Board board{4, 5};
+    Solver solver(board, pieces);
+    EXPECT_FALSE(solver.solve());
+}
+
+TEST(FeasibilityTest, UncoverableCellTest) {
+    // X and a long plus never reach the corners of a 3x4 board
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({9});
+    pieces.emplace_back(Piece{20, {{1, 0}, {0, 1}, {1, 1}, {2, 1}, {1, 2}, {1, 3}}});
+    FeasibilityReport report = check_feasibility(3, 4, pieces);
+    EXPECT_FALSE(report.feasible);
+    EXPECT_EQ("Cell (0, 0) cannot be covered by any piece placement.", report.reason);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "../src/engine/board.h"
+#include "../src/engine/frontier_counter.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solver.h"
+#include "../src/game/level_loader.h"
+
+static uint64_t solver_count(int w, int h, const std::vector<Piece>& pieces) {
+    Board board(w, h);
+    Solver solver(board, pieces);
+    return solver.count_solutions();
+}
+
+TEST(FrontierCounterTest, MatchesSolverTest) {
+    // repeated kinds, both orientations of the scan, and a board of more
+    // than 64 cells
+    const std::vector<std::tuple<int, int, std::vector<int>>> cases = {
+        {10, 6, std::vector<int>(12, 3)},
+        {6, 10, std::vector<int>(12, 3)},
+        {5, 4, {1, 2, 3, 4}},
+        {4, 5, {1, 2, 3, 4}},
+        {20, 4, std::vector<int>(16, 3)},
+    };
+    for (const auto& [w, h, ids] : cases) {
+        const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(ids);
+        ASSERT_TRUE(FrontierCounter::supports(w, h, pieces));
+        FrontierCounter counter(w, h, pieces);
+        EXPECT_EQ(counter.count(), solver_count(w, h, pieces)) << w << "x" << h;
+        EXPECT_GT(counter.get_peak_states(), 0u);
+    }
+
+    EXPECT_FALSE(FrontierCounter::supports(7, 7));
+    EXPECT_THROW(FrontierCounter(7, 7, PieceLibrary::make_all_pieces()), std::invalid_argument);
+
+    // a table too small for the widest scan position
+    FrontierCounter tiny(10, 6, PieceLibrary::make_all_pieces(), 100);
+    EXPECT_THROW(tiny.count(), std::length_error);
+}
+
+TEST(FrontierCounterTest, EveryLevelTest) {
+    int levels = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator("../levels")) {
+        if (entry.path().extension() != ".txt") continue;
+        LevelData ld = LevelLoader::load_level(entry.path().string());
+        if (!FrontierCounter::supports(ld.width, ld.height, ld.pieces)) continue;
+
+        FrontierCounter counter(ld.width, ld.height, ld.pieces);
+        EXPECT_EQ(counter.count(), solver_count(ld.width, ld.height, ld.pieces)) << entry.path();
+        ++levels;
+    }
+    EXPECT_GT(levels, 0);
+}
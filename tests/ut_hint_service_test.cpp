@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../src/engine/piece_library.h"
+#include "../src/web/hint_service.h"
+
+static HintRequest level_5x5() {
+    HintRequest req;
+    req.width = 5;
+    req.height = 5;
+    req.piece_ids = {0, 3, 11, 10, 4};
+    return req;
+}
+
+static HintPiece as_placed(const PlacementDTO& p) {
+    HintPiece hp;
+    hp.pieceId = p.pieceId;
+    hp.cells = p.cells;
+    return hp;
+}
+
+TEST(HintServiceTest, FollowHintsToCompletionTest) {
+    HintService hints;
+    HintRequest req = level_5x5();
+
+    for (size_t i = 0; i < req.piece_ids.size(); ++i) {
+        HintResult r = hints.hint(req);
+        ASSERT_EQ(HintStatus::Next, r.status) << r.error_message;
+        EXPECT_EQ(HintSource::Cache, r.source);
+        req.placed.push_back(as_placed(r.next));
+    }
+    EXPECT_EQ(HintStatus::Complete, hints.hint(req).status);
+    EXPECT_EQ(1u, hints.cached_levels());
+
+    hints.clear();
+    EXPECT_EQ(0u, hints.cached_levels());
+}
+
+// Challenge1 level 1: 7x5, pieces 8 (I) 0 1 3 11 4 9
+static HintRequest level_7x5_with_i(bool upright, int x, int y) {
+    HintRequest req;
+    req.width = 7;
+    req.height = 5;
+    req.piece_ids = {8, 0, 1, 3, 11, 4, 9};
+
+    HintPiece i_piece;
+    i_piece.pieceId = 8;
+    for (int k = 0; k < 5; ++k) {
+        i_piece.cells.push_back(upright ? CellDTO{x, y + k} : CellDTO{x + k, y});
+    }
+    req.placed.push_back(i_piece);
+    return req;
+}
+
+TEST(HintServiceTest, DeadEndTest) {
+    // the upright I in column 1 leaves column 0 for a second I
+    HintService hints;
+    HintResult r = hints.hint(level_7x5_with_i(true, 1, 0));
+    EXPECT_EQ(HintStatus::DeadEnd, r.status);
+    EXPECT_EQ(HintSource::Cache, r.source);
+}
+
+TEST(HintServiceTest, BoundedSearchFallbackTest) {
+    // lying I on the bottom row: solvable, but not in the first solution
+    HintRequest req = level_7x5_with_i(false, 0, 4);
+    HintResult full = HintService().hint(req);
+    ASSERT_EQ(HintStatus::Next, full.status);
+    EXPECT_EQ(HintSource::Cache, full.source);
+
+    // a set cut at one solution cannot prove anything, so the miss is searched
+    HintService capped(16, 1, 1000000);
+    HintResult searched = capped.hint(req);
+    ASSERT_EQ(HintStatus::Next, searched.status);
+    EXPECT_EQ(HintSource::Search, searched.source);
+    EXPECT_GT(searched.nodes, 0u);
+    EXPECT_EQ(HintStatus::DeadEnd, capped.hint(level_7x5_with_i(true, 1, 0)).status);
+
+    HintService starved(16, 1, 1);
+    EXPECT_EQ(HintStatus::Unknown, starved.hint(req).status);
+}
+
+TEST(HintServiceTest, EnumerationBudgetTest) {
+    // the set stops after a handful of nodes; the miss goes to the bounded search
+    HintService budgeted(16, 50000, 1000000, 10);
+    HintResult r = budgeted.hint(level_7x5_with_i(false, 0, 4));
+    ASSERT_EQ(HintStatus::Next, r.status);
+    EXPECT_EQ(HintSource::Search, r.source);
+    EXPECT_EQ(1u, budgeted.cached_levels());
+
+    // without a complete set a dead end is only proven by the search
+    r = budgeted.hint(level_7x5_with_i(true, 1, 0));
+    EXPECT_EQ(HintStatus::DeadEnd, r.status);
+    EXPECT_EQ(HintSource::Search, r.source);
+}
+
+TEST(HintServiceTest, RejectsBadPlacementsTest) {
+    HintService hints;
+    HintRequest req = level_5x5();
+
+    HintPiece wrong;
+    wrong.pieceId = 7;      // not in the level
+    wrong.cells = {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}};
+    req.placed.push_back(wrong);
+    EXPECT_EQ(HintStatus::Invalid, hints.hint(req).status);
+
+    req.placed[0].pieceId = 4;
+    req.placed[0].cells = {{0, 0}, {1, 0}, {2, 0}, {3, 1}, {4, 1}};   // not a shape of 4
+    HintResult r = hints.hint(req);
+    EXPECT_EQ(HintStatus::Invalid, r.status);
+    EXPECT_FALSE(r.error_message.empty());
+}
+
+TEST(HintServiceTest, EvictsLeastRecentlyUsedTest) {
+    HintService hints(2);
+    HintRequest a = level_5x5();
+    HintRequest b = level_7x5_with_i(false, 0, 4);
+    b.placed.clear();
+    HintRequest c;
+    c.width = 3;
+    c.height = 5;
+    c.piece_ids = {0, 1, 2};
+
+    ASSERT_EQ(HintStatus::Next, hints.hint(a).status);
+    ASSERT_EQ(HintStatus::Next, hints.hint(b).status);
+    ASSERT_EQ(HintStatus::Next, hints.hint(a).status);     // a is now the most recent
+    ASSERT_EQ(HintStatus::Next, hints.hint(c).status);     // evicts b
+    EXPECT_EQ(2u, hints.cached_levels());
+    EXPECT_TRUE(hints.is_cached(a.width, a.height, a.piece_ids));
+    EXPECT_FALSE(hints.is_cached(b.width, b.height, b.piece_ids));
+    EXPECT_TRUE(hints.is_cached(c.width, c.height, c.piece_ids));
+}
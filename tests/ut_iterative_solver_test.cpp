@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include "../src/engine/board.h"
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solver.h"
+#include "../src/engine/transposition_table.h"
+
+TEST(IterativeSolverTest, MatchesSolverTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1, 7, 11});
+
+    Board board{6, 5};
+    Solver solver(board, pieces);
+    ASSERT_TRUE(solver.solve());
+
+    IterativeSolver iterative(6, 5, pieces);
+    ASSERT_TRUE(iterative.solve());
+
+    const auto& expected = solver.get_placements_path();
+    const auto actual = iterative.get_placements_path();
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].get_piece_id(), actual[i].get_piece_id());
+        EXPECT_EQ(expected[i].get_variant_index(), actual[i].get_variant_index());
+        EXPECT_EQ(expected[i].get_offset(), actual[i].get_offset());
+    }
+
+    board.clear();
+    EXPECT_EQ(solver.count_solutions(), iterative.count_solutions());
+}
+
+TEST(IterativeSolverTest, NoSolutionTest) {
+    std::vector<Piece> pieces{Piece{0, {{0, 0}, {1, 0}, {2, 0}}}};
+    IterativeSolver solver(2, 2, pieces);
+    EXPECT_FALSE(solver.solve());
+    EXPECT_EQ(SearchStatus::Exhausted, solver.next());
+}
+
+TEST(IterativeSolverTest, PauseAndResumeTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 1, 2, 3, 4, 5, 6});
+
+    IterativeSolver reference(7, 5, pieces);
+    const uint64_t total = reference.count_solutions();
+    ASSERT_GT(total, 0u);
+
+    // run in small slices, each time persisting and resuming on a new solver
+    std::filesystem::path file = std::filesystem::temp_directory_path() / "ut_search_checkpoint.bin";
+    IterativeSolver first(7, 5, pieces);
+    first.checkpoint().save(file.string());
+
+    uint64_t found = 0;
+    int slices = 0;
+    while (true) {
+        IterativeSolver worker(7, 5, pieces);
+        worker.resume(SearchCheckpoint::load(file.string()));
+
+        SearchStatus status = worker.next(500);
+        if (status == SearchStatus::Exhausted) break;
+        if (status == SearchStatus::Found) ++found;
+
+        worker.checkpoint().save(file.string());
+        ++slices;
+    }
+    std::filesystem::remove(file);
+
+    EXPECT_GT(slices, 1);
+    EXPECT_EQ(total, found);
+}
+
+TEST(IterativeSolverTest, CheckpointRoundTripTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 1, 2, 3});
+    IterativeSolver solver(4, 5, pieces);
+    ASSERT_TRUE(solver.solve());
+
+    SearchCheckpoint cp = solver.checkpoint();
+    EXPECT_TRUE(cp.at_solution);
+    EXPECT_EQ(4, cp.decisions.size());
+
+    SearchCheckpoint copy = SearchCheckpoint::deserialize(cp.serialize());
+    EXPECT_EQ(cp.decisions, copy.decisions);
+    EXPECT_EQ(cp.piece_left, copy.piece_left);
+    EXPECT_EQ(cp.piece_ids, copy.piece_ids);
+    EXPECT_TRUE(copy.at_solution);
+
+    IterativeSolver other(4, 5, pieces);
+    other.resume(copy);
+    EXPECT_EQ(solver.get_decisions(), other.get_decisions());
+
+    // wrong instance
+    IterativeSolver wrong(4, 5, PieceLibrary::get_piece_by_id({0, 1, 2, 4}));
+    EXPECT_THROW(wrong.resume(copy), std::invalid_argument);
+
+    std::vector<uint8_t> bad = cp.serialize();
+    bad.pop_back();
+    EXPECT_THROW(SearchCheckpoint::deserialize(bad), std::runtime_error);
+}
+
+TEST(IterativeSolverTest, PrefilledBoardTest) {
+    // 3x5 with pieces 0 1 2; pretend piece 0 already covers its cells
+    auto all = PieceLibrary::get_piece_by_id({0, 1, 2});
+    IterativeSolver full(3, 5, all);
+    ASSERT_TRUE(full.solve());
+
+    uint64_t prefilled = 0;
+    const auto path = full.get_placements_path();
+    for (const auto& p : path) {
+        if (p.get_piece_id() != 0) continue;
+        for (const auto& c : all[0].get_variants()[p.get_variant_index()]) {
+            prefilled |= 1ull << ((c.y + p.get_offset().y) * 3 + c.x + p.get_offset().x);
+        }
+    }
+
+    IterativeSolver rest(3, 5, PieceLibrary::get_piece_by_id({1, 2}));
+    rest.reset(prefilled);
+    ASSERT_EQ(SearchStatus::Found, rest.next());
+    EXPECT_EQ(2u, rest.get_placements_path().size());
+
+    rest.reset(0);
+    EXPECT_EQ(SearchStatus::Exhausted, rest.next());
+}
+
+TEST(IterativeSolverTest, TranspositionTableCountTest) {
+    // 6x5 with six pentominoes, counted with and without the memo
+    auto pieces = PieceLibrary::get_piece_by_id({0, 1, 3, 4, 9, 10});
+    IterativeSolver plain(6, 5, pieces);
+    const uint64_t expected = plain.count_solutions();
+
+    TranspositionTable memo(1u << 16);
+    IterativeSolver solver(6, 5, pieces);
+    solver.set_transposition_table(&memo);
+    EXPECT_EQ(expected, solver.count_solutions());
+    EXPECT_LE(solver.get_stats().nodes, plain.get_stats().nodes);
+    EXPECT_GT(memo.stats().stores, 0u);
+
+    // a second pass is answered at the root from the table
+    EXPECT_EQ(expected, solver.count_solutions());
+    EXPECT_EQ(0u, solver.get_stats().nodes);
+
+    if (expected > 1) {
+        memo.clear();
+        EXPECT_EQ(1u, solver.count_solutions(1));
+    }
+}
+
+TEST(IterativeSolverTest, TranspositionTableEnumerationTest) {
+    // dead states learned while enumerating must not lose or reorder solutions
+    auto pieces = PieceLibrary::get_piece_by_id({8, 0, 1, 3, 11, 4, 9});
+    IterativeSolver plain(7, 5, pieces);
+    TranspositionTable memo(1u << 12);     // tiny, so entries get evicted
+    IterativeSolver solver(7, 5, pieces);
+    solver.set_transposition_table(&memo);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        plain.reset();
+        solver.reset();
+        while (true) {
+            SearchStatus a = plain.next();
+            SearchStatus b = solver.next();
+            ASSERT_EQ(a, b);
+            if (a != SearchStatus::Found) break;
+            EXPECT_EQ(plain.get_decisions(), solver.get_decisions());
+        }
+    }
+    EXPECT_GT(memo.stats().hits, 0u);
+    EXPECT_GT(memo.stats().evictions, 0u);
+    EXPECT_LT(solver.get_stats().nodes, plain.get_stats().nodes);
+}
+
+TEST(TranspositionTableTest, EvictsLeastWorkTest) {
+    TranspositionTable memo(0);     // a single bucket of four
+    EXPECT_EQ(4u, memo.capacity());
+
+    for (uint64_t i = 1; i <= 4; ++i) memo.store(i, 0, 0, i * 10);
+    memo.store(5, 0, 7, 25);
+
+    uint64_t count = 0;
+    EXPECT_FALSE(memo.probe(1, 0, count));  // least work, evicted
+    EXPECT_TRUE(memo.probe(2, 0, count));
+    EXPECT_TRUE(memo.probe(5, 0, count));
+    EXPECT_EQ(7u, count);
+    EXPECT_FALSE(memo.probe(5, 1, count));  // same cells, other pieces left
+    EXPECT_EQ(1u, memo.stats().evictions);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "../src/web/json_body.h"
+
+using json = nlohmann::json;
+
+TEST(JsonBodyTest, AcceptPrecedenceTest) {
+    const json body = {{"solved", true}, {"placements", json::array({1, 2, 3})}};
+    auto type = [&](const std::string& accept) { return encode_body(body, accept).content_type; };
+
+    EXPECT_EQ(type(""), "application/json; charset=utf-8");
+    EXPECT_EQ(type("text/html, */*"), "application/json; charset=utf-8");
+    EXPECT_EQ(type("application/cbor"), "application/cbor");
+    EXPECT_EQ(type("application/msgpack"), "application/msgpack");
+    EXPECT_EQ(type("application/x-msgpack"), "application/msgpack");
+
+    // the first type named wins, whatever the quality values say
+    EXPECT_EQ(type("application/json, application/cbor"), "application/json; charset=utf-8");
+    EXPECT_EQ(type("application/cbor;q=0.1, application/json"), "application/cbor");
+    EXPECT_EQ(type("application/msgpack, application/cbor"), "application/msgpack");
+    EXPECT_EQ(type("application/cbor, application/x-msgpack, application/json"), "application/cbor");
+
+    const EncodedBody text = encode_body(body, "");
+    EXPECT_EQ(text.content, body.dump());
+    EXPECT_EQ(text.content.find('\n'), std::string::npos);
+    EXPECT_EQ(json::from_cbor(encode_body(body, "application/cbor").content), body);
+    EXPECT_EQ(json::from_msgpack(encode_body(body, "application/msgpack").content), body);
+}
+
+TEST(JsonBodyTest, CellEncodingTest) {
+    PlacementDTO p;
+    p.pieceId = 4;
+    p.variantIndex = 2;
+    p.cells = {CellDTO{0, 0}, CellDTO{2, 1}, CellDTO{4, 2}};
+
+    const json points = placements_json({p});
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_EQ(points[0]["pieceId"], 4);
+    EXPECT_EQ(points[0]["variantIndex"], 2);
+    EXPECT_EQ(points[0]["cells"][1], json({{"x", 2}, {"y", 1}}));
+
+    // "cells": "index" on a 5-wide board: y * 5 + x
+    const json indices = placements_json({p}, 5);
+    EXPECT_EQ(indices[0]["cells"], json({0, 7, 14}));
+    EXPECT_EQ(indices[0]["pieceId"], 4);
+
+    EXPECT_EQ(placements_json({}), json::array());
+}
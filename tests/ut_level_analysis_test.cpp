@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/level_analysis.h"
+#include "../src/engine/piece_library.h"
+
+// Branches added up must give what one sequential search sees.
+static void expect_matches_sequential(int w, int h, const std::vector<int>& ids) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(ids);
+
+    IterativeSolver first(w, h, pieces);
+    const bool solvable = first.solve();
+    const uint64_t nodes_to_first = first.get_stats().nodes;
+
+    IterativeSolver all(w, h, pieces);
+    const uint64_t count = all.count_solutions();
+
+    LevelAnalyzer analyzer(w, h, pieces);
+    LevelAnalysis a = analyzer.run();
+    EXPECT_TRUE(a.feasible);
+    EXPECT_EQ(solvable, a.solvable);
+    EXPECT_EQ(count, a.solution_count);
+    EXPECT_EQ(all.get_stats().nodes, a.nodes);
+    if (solvable) {
+        EXPECT_EQ(nodes_to_first, a.nodes_to_first);
+    }
+    EXPECT_TRUE(a.complete);
+}
+
+TEST(LevelAnalysisTest, MatchesSequentialSearchTest) {
+    expect_matches_sequential(6, 5, {0, 6, 3, 1, 7, 11});
+    expect_matches_sequential(5, 5, {0, 3, 11, 10, 4});
+}
+
+TEST(LevelAnalysisTest, RepeatedPiecesTest) {
+    // removing a root copy must not reorder the kinds below it
+    expect_matches_sequential(5, 4, {6, 8, 6, 11});
+    expect_matches_sequential(4, 5, {2, 5, 2, 7});
+}
+
+TEST(LevelAnalysisTest, InfeasibleLevelTest) {
+    LevelAnalyzer analyzer(2, 10, PieceLibrary::get_piece_by_id({8, 9}));
+    EXPECT_EQ(0, analyzer.branch_count());
+
+    LevelAnalysis a = analyzer.run();
+    EXPECT_FALSE(a.feasible);
+    EXPECT_FALSE(a.reason.empty());
+    EXPECT_FALSE(a.solvable);
+    EXPECT_EQ(0, a.difficulty());
+}
+
+TEST(LevelAnalysisTest, LimitTest) {
+    LevelAnalyzer analyzer(6, 5, PieceLibrary::get_piece_by_id({0, 6, 3, 1, 7, 11}), 1);
+    LevelAnalysis a = analyzer.run();
+    EXPECT_TRUE(a.solvable);
+    EXPECT_EQ(1, a.solution_count);
+    EXPECT_FALSE(a.complete);
+}
+
+TEST(LevelAnalysisTest, DifficultyTest) {
+    LevelAnalysis a;
+    a.solvable = true;
+    a.solution_count = 4;
+    a.nodes = 40;
+    EXPECT_DOUBLE_EQ(1.0, a.difficulty_score());
+    EXPECT_EQ(1, a.difficulty());
+
+    a.nodes = 400000;
+    EXPECT_EQ(5, a.difficulty());
+}
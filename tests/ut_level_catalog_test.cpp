@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "../src/web/level_catalog.h"
+
+namespace fs = std::filesystem;
+
+static void write_level(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path);
+    out << content;
+}
+
+TEST(LevelCatalogTest, LoadAllTest) {
+    fs::path root = fs::temp_directory_path() / "ut_level_catalog_load";
+    fs::remove_all(root);
+    write_level(root / "g1" / "levels1.txt", "3 5\n\n0 1 2\n");
+    write_level(root / "g1" / "levels2.txt", "4 5\n\n0 1 2 3\n");
+
+    LevelCatalogStore store(root.string());
+    store.load_all();
+
+    auto snap = store.snapshot();
+    ASSERT_EQ(1, snap->groups.size());
+    EXPECT_EQ("g1", snap->groups[0].id);
+    ASSERT_EQ(2, snap->groups[0].levels.size());
+    EXPECT_EQ("levels1", snap->groups[0].levels[0].id);
+    EXPECT_EQ(4, snap->groups[0].levels[1].width);
+
+    fs::remove_all(root);
+}
+
+TEST(LevelCatalogTest, ReloadSwapsSnapshotTest) {
+    fs::path root = fs::temp_directory_path() / "ut_level_catalog_reload";
+    fs::remove_all(root);
+    write_level(root / "g1" / "levels1.txt", "3 5\n\n0 1 2\n");
+
+    LevelCatalogStore store(root.string());
+    uint64_t notified = 0;
+    store.on_reload([&](uint64_t gen) { notified = gen; });
+    store.load_all();
+
+    auto old_snap = store.snapshot();
+
+    // edit one file, add a group, then reparse only those paths
+    write_level(root / "g1" / "levels1.txt", "4 5\n\n0 1 2 3\n");
+    write_level(root / "g2" / "levels1.txt", "3 5\n\n0 6 3\n");
+    store.reload_paths({(root / "g1" / "levels1.txt").string(), (root / "g2").string()});
+
+    auto snap = store.snapshot();
+    EXPECT_EQ(old_snap->generation + 1, snap->generation);
+    EXPECT_EQ(snap->generation, notified);
+    ASSERT_EQ(2, snap->groups.size());
+    EXPECT_EQ(4, snap->groups[0].levels[0].width);
+    ASSERT_NE(nullptr, snap->find_level("g2", "levels1"));
+
+    // the old snapshot is untouched
+    ASSERT_EQ(1, old_snap->groups.size());
+    EXPECT_EQ(3, old_snap->groups[0].levels[0].width);
+
+    // removal
+    fs::remove_all(root / "g2");
+    store.reload_paths({(root / "g2").string()});
+    EXPECT_EQ(1, store.snapshot()->groups.size());
+
+    fs::remove_all(root);
+}
+
+TEST(LevelCatalogTest, EmptyGroupListedTest) {
+    fs::path root = fs::temp_directory_path() / "ut_level_catalog_empty";
+    fs::remove_all(root);
+    write_level(root / "g1" / "levels1.txt", "3 5\n\n0 1 2\n");
+    write_level(root / "g2" / "broken.txt", "not a level\n");
+    fs::create_directories(root / "g3");
+
+    LevelCatalogStore store(root.string());
+    store.load_all();
+
+    auto snap = store.snapshot();
+    ASSERT_EQ(3, snap->groups.size());
+    EXPECT_EQ("g2", snap->groups[1].id);
+    EXPECT_TRUE(snap->groups[1].levels.empty());
+    EXPECT_EQ("g3", snap->groups[2].id);
+
+    // a new empty folder shows up, a removed one goes away
+    fs::create_directories(root / "g4");
+    fs::remove_all(root / "g3");
+    store.reload_paths({(root / "g4").string(), (root / "g3").string()});
+    snap = store.snapshot();
+    ASSERT_EQ(3, snap->groups.size());
+    EXPECT_EQ("g4", snap->groups[2].id);
+
+    fs::remove_all(root);
+}
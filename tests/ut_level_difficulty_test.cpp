@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "../src/web/level_difficulty.h"
+
+namespace fs = std::filesystem;
+
+TEST(LevelDifficultyTest, LoadCsvTest) {
+    fs::path file = fs::temp_directory_path() / "ut_level_difficulty.csv";
+    {
+        std::ofstream out(file);
+        out << "group,level,width,solvable,solutions,difficulty_score,difficulty\n"
+               "The small slam,levels1,4,1,4,0.628,1\n"
+               "\"a,\"\"b\"\"\",levels2,5,0,0,0.000,0\n";
+    }
+
+    auto table = LevelDifficultyTable::load_csv(file.string());
+    EXPECT_EQ(2, table->size());
+
+    const LevelRating* r = table->find("The small slam", "levels1");
+    ASSERT_NE(nullptr, r);
+    EXPECT_EQ(1, r->difficulty);
+    EXPECT_TRUE(r->solvable);
+    EXPECT_EQ(4, r->solution_count);
+
+    r = table->find("a,\"b\"", "levels2");
+    ASSERT_NE(nullptr, r);
+    EXPECT_FALSE(r->solvable);
+
+    EXPECT_EQ(nullptr, table->find("The small slam", "levels9"));
+    fs::remove(file);
+}
+
+TEST(LevelDifficultyTest, RejectsOtherCsvTest) {
+    fs::path file = fs::temp_directory_path() / "ut_level_difficulty_bad.csv";
+    {
+        std::ofstream out(file);
+        out << "name,score\nx,1\n";
+    }
+    EXPECT_THROW(LevelDifficultyTable::load_csv(file.string()), std::runtime_error);
+    fs::remove(file);
+}
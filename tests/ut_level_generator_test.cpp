@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/level_generator.h"
+#include "../src/engine/piece_library.h"
+
+TEST(LevelGeneratorTest, SampleTest) {
+    GeneratorConstraints limits;
+    limits.min_pieces = 4;
+    limits.max_pieces = 7;
+    LevelGenerator gen(limits, 42);
+
+    for (uint64_t i = 0; i < 200; ++i) {
+        LevelCandidate c = gen.sample(i);
+        ASSERT_GE(c.piece_ids.size(), 4);
+        ASSERT_LE(c.piece_ids.size(), 7);
+        ASSERT_TRUE(std::is_sorted(c.piece_ids.begin(), c.piece_ids.end()));
+        ASSERT_EQ(std::adjacent_find(c.piece_ids.begin(), c.piece_ids.end()), c.piece_ids.end());
+
+        int area = 0;
+        for (const auto& p : PieceLibrary::get_piece_by_id(c.piece_ids)) area += (int)p.get_shape().size();
+        EXPECT_EQ(area, c.width * c.height);
+        EXPECT_EQ(5, c.height);
+
+        // pure function of (seed, index)
+        EXPECT_EQ(c.piece_ids, gen.sample(i).piece_ids);
+    }
+    EXPECT_NE(gen.sample(0).piece_ids, LevelGenerator(limits, 43).sample(0).piece_ids);
+}
+
+TEST(LevelGeneratorTest, CheckMatchesSolverTest) {
+    LevelGenerator gen(GeneratorConstraints{}, 1);
+    int accepted = 0, unsolvable = 0;
+    for (uint64_t i = 0; i < 60; ++i) {
+        LevelCandidate c = gen.sample(i);
+        const CandidateVerdict v = gen.check(c);
+        IterativeSolver solver(c.width, c.height, PieceLibrary::get_piece_by_id(c.piece_ids));
+        EXPECT_EQ(solver.solve(), v == CandidateVerdict::Accepted) << to_string(v);
+        if (v == CandidateVerdict::Accepted) ++accepted;
+        if (v == CandidateVerdict::Unsolvable) ++unsolvable;
+    }
+    EXPECT_GT(accepted, 0);
+    EXPECT_GT(unsolvable, 0);
+}
+
+TEST(LevelGeneratorTest, UniqueAndBandTest) {
+    GeneratorConstraints limits;
+    limits.unique = true;
+    LevelGenerator unique(limits, 1);
+
+    // Challenge1: 24 solutions
+    LevelCandidate many;
+    many.width = 7;
+    many.height = 5;
+    many.piece_ids = {0, 1, 3, 4, 8, 9, 11};
+    EXPECT_EQ(CandidateVerdict::NotUnique, unique.check(many));
+    EXPECT_GT(many.solutions, 4);
+
+    // one tiling, seen 4 times through the board's symmetries
+    LevelCandidate easy;
+    easy.width = 3;
+    easy.height = 5;
+    easy.piece_ids = {0, 1, 2};
+    EXPECT_EQ(CandidateVerdict::Accepted, unique.check(easy));
+    EXPECT_EQ(4, easy.solutions);
+
+    limits.unique = false;
+    limits.min_difficulty = 4;
+    EXPECT_EQ(CandidateVerdict::OutOfBand, LevelGenerator(limits, 1).check(easy));
+    EXPECT_EQ(1, easy.difficulty);
+}
+
+TEST(LevelGeneratorTest, BadConstraintsTest) {
+    GeneratorConstraints limits;
+    limits.max_pieces = 13;
+    EXPECT_THROW(LevelGenerator(limits, 1), std::invalid_argument);
+
+    limits.max_pieces = 5;
+    limits.min_difficulty = 4;
+    limits.max_difficulty = 2;
+    EXPECT_THROW(LevelGenerator(limits, 1), std::invalid_argument);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "../src/web/level_pack.h"
+
+TEST(LevelPackTest, InstanceKeyIgnoresOrderTest) {
+    EXPECT_EQ(levelpack::instance_key(3, 5, {0, 1, 2}), levelpack::instance_key(3, 5, {2, 0, 1}));
+    EXPECT_NE(levelpack::instance_key(3, 5, {0, 1, 2}), levelpack::instance_key(5, 3, {0, 1, 2}));
+}
+
+TEST(LevelPackTest, WriteAndMapTest) {
+    std::filesystem::path file = std::filesystem::temp_directory_path() / "ut_level_pack.pack";
+
+    levelpack::SourceLevel lv;
+    lv.id = "levels1";
+    lv.width = 3;
+    lv.height = 5;
+    lv.piece_ids = {2, 0, 1};
+    lv.status = levelpack::kStatusSolved;
+    lv.path = {Placement{0, 1, Cell{0, 0}}, Placement{2, 3, Cell{-1, 2}}};
+    lv.solution_count = 4;
+
+    levelpack::SourceGroup group{"The small slam", {lv}};
+    levelpack::write_pack(file.string(), {group}, true);
+
+    auto pack = LevelPack::open(file.string());
+    ASSERT_TRUE(pack->has_solutions());
+    ASSERT_EQ(1u, pack->group_count());
+    ASSERT_EQ(1u, pack->level_count());
+    EXPECT_EQ("The small slam", pack->group_name(pack->group(0)));
+
+    const auto& stored = pack->level(0);
+    EXPECT_EQ("levels1", pack->level_id(stored));
+    EXPECT_EQ(3, stored.width);
+    EXPECT_EQ(5, stored.height);
+    EXPECT_EQ(4u, stored.solution_count);
+
+    auto sol = pack->solution(stored);
+    ASSERT_EQ(2u, sol.size());
+    EXPECT_EQ(2, sol[1].piece_id);
+    EXPECT_EQ(-1, sol[1].x);
+
+    EXPECT_EQ(&stored, pack->find_level(3, 5, {0, 1, 2}));
+    EXPECT_EQ(nullptr, pack->find_level(3, 5, {0, 1, 3}));
+
+    pack.reset();
+    std::filesystem::remove(file);
+}
+
+TEST(LevelPackTest, RejectsCorruptOffsetsTest) {
+    std::filesystem::path file = std::filesystem::temp_directory_path() / "ut_level_pack_corrupt.pack";
+
+    levelpack::SourceLevel lv;
+    lv.id = "levels1";
+    lv.width = 3;
+    lv.height = 5;
+    lv.piece_ids = {2, 0, 1};
+    lv.status = levelpack::kStatusSolved;
+    lv.path = {Placement{0, 1, Cell{0, 0}}};
+    levelpack::write_pack(file.string(), {levelpack::SourceGroup{"g", {lv}}}, true);
+
+    std::vector<char> good;
+    {
+        std::ifstream in(file, std::ios::binary);
+        good.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    levelpack::PackHeader h;
+    std::memcpy(&h, good.data(), sizeof(h));
+
+    auto write = [&](const std::vector<char>& bytes) {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), (std::streamsize)bytes.size());
+    };
+    auto patch_level = [&](auto edit) {
+        std::vector<char> bytes = good;
+        levelpack::PackLevel pl;
+        std::memcpy(&pl, bytes.data() + h.levels_offset, sizeof(pl));
+        edit(pl);
+        std::memcpy(bytes.data() + h.levels_offset, &pl, sizeof(pl));
+        write(bytes);
+    };
+
+    patch_level([](levelpack::PackLevel& pl) { pl.placement_count = 1000000; });
+    EXPECT_THROW(LevelPack::open(file.string()), std::runtime_error);
+    patch_level([](levelpack::PackLevel& pl) { pl.piece_offset = 0xfffffff0u; });
+    EXPECT_THROW(LevelPack::open(file.string()), std::runtime_error);
+    patch_level([](levelpack::PackLevel& pl) { pl.id_length = 4096; });
+    EXPECT_THROW(LevelPack::open(file.string()), std::runtime_error);
+
+    // truncated, with a header claiming the shorter size
+    {
+        std::vector<char> bytes(good.begin(), good.begin() + (long)h.strings_offset);
+        levelpack::PackHeader cut = h;
+        cut.file_size = bytes.size();
+        std::memcpy(bytes.data(), &cut, sizeof(cut));
+        write(bytes);
+        EXPECT_THROW(LevelPack::open(file.string()), std::runtime_error);
+    }
+
+    write(good);
+    EXPECT_NO_THROW(LevelPack::open(file.string()));
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/perf_counters.h"
+#include "../src/engine/piece_library.h"
+
+// Counters may or may not exist where the tests run (containers, VMs without
+// a PMU): check what holds either way.
+TEST(PerfCountersTest, DegradesGracefullyTest) {
+    PerfCounters counters;
+    if (!counters.hardware_available()) {
+        EXPECT_FALSE(counters.reason().empty());
+    }
+
+    counters.start();
+    IterativeSolver solver(10, 6, PieceLibrary::make_all_pieces());
+    ASSERT_TRUE(solver.solve());
+    const PerfSample sample = counters.stop();
+
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (sample.available[i]) {
+            EXPECT_TRUE(counters.available()) << to_string((PerfEvent)i);
+        } else {
+            EXPECT_EQ(sample.value[i], 0u) << to_string((PerfEvent)i);
+        }
+    }
+    if (sample.has(PerfEvent::Instructions)) {
+        EXPECT_GT(sample.get(PerfEvent::Instructions), 0u);
+    }
+    if (sample.has(PerfEvent::TaskClock)) {
+        EXPECT_GT(sample.get(PerfEvent::TaskClock), 0u);
+    }
+
+    // counters can be stopped again (or restarted) and report the same events
+    const PerfSample again = counters.stop();
+    for (int i = 0; i < kPerfEventCount; ++i) EXPECT_EQ(again.available[i], sample.available[i]);
+}
+
+TEST(PerfCountersTest, ReportRatiosTest) {
+    PerfReport report;
+    EXPECT_EQ(report.per_node(PerfEvent::Cycles), 0.0);
+    EXPECT_EQ(report.ipc(), 0.0);
+
+    report.stats.nodes = 100;
+    report.stats.placement_tests = 400;
+    report.sample.available[(int)PerfEvent::Cycles] = true;
+    report.sample.value[(int)PerfEvent::Cycles] = 2000;
+    report.sample.available[(int)PerfEvent::Instructions] = true;
+    report.sample.value[(int)PerfEvent::Instructions] = 3000;
+
+    EXPECT_DOUBLE_EQ(report.per_node(PerfEvent::Cycles), 20.0);
+    EXPECT_DOUBLE_EQ(report.per_test(PerfEvent::Cycles), 5.0);
+    EXPECT_DOUBLE_EQ(report.ipc(), 1.5);
+    EXPECT_EQ(report.per_node(PerfEvent::BranchMisses), 0.0);   // not counted
+
+    PerfReport twice = report;
+    twice.sample += report.sample;
+    EXPECT_EQ(twice.sample.get(PerfEvent::Cycles), 4000u);
+    EXPECT_FALSE(twice.sample.has(PerfEvent::LlcMisses));
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/engine/piece_library.h"
+#include "../src/engine/portfolio_solver.h"
+
+// Every cell covered exactly once by the path's placements.
+static bool is_tiling(int w, int h, const std::vector<Piece>& pieces, const std::vector<Placement>& path) {
+    std::vector<int> grid(w * h, 0);
+    for (const auto& p : path) {
+        const Piece* piece = nullptr;
+        for (const auto& q : pieces) {
+            if (q.get_id() == p.get_piece_id()) piece = &q;
+        }
+        if (!piece) return false;
+        for (const auto& c : piece->get_variants()[p.get_variant_index()]) {
+            const int x = c.x + p.get_offset().x;
+            const int y = c.y + p.get_offset().y;
+            if (x < 0 || y < 0 || x >= w || y >= h || grid[y * w + x]++) return false;
+        }
+    }
+    return path.size() == pieces.size();
+}
+
+TEST(PortfolioSolverTest, HeadStartAnswersEasyLevelTest) {
+    auto pieces = PieceLibrary::get_piece_by_id({8, 0, 1, 3, 11, 4, 9});
+    PortfolioResult r = solve_portfolio(7, 5, pieces);
+    ASSERT_TRUE(r.solved);
+    EXPECT_EQ(PortfolioStrategy::TableOrder, r.winner);
+    EXPECT_EQ(1, r.threads);
+    EXPECT_TRUE(is_tiling(7, 5, pieces, r.path));
+}
+
+TEST(PortfolioSolverTest, RaceReturnsValidTilingTest) {
+    PortfolioOptions options;
+    options.threads = kPortfolioStrategies;
+    options.head_start_nodes = 1;
+    options.check_every = 64;
+
+    for (auto [w, h] : std::vector<std::pair<int, int>>{{12, 5}, {10, 6}, {8, 5}}) {
+        auto ids = w * h == 60 ? std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}
+                               : std::vector<int>{0, 2, 3, 4, 5, 6, 9, 10};
+        auto pieces = PieceLibrary::get_piece_by_id(ids);
+        PortfolioResult r = solve_portfolio(w, h, pieces, options);
+        ASSERT_TRUE(r.solved) << w << "x" << h;
+        EXPECT_EQ(kPortfolioStrategies, r.threads);
+        EXPECT_TRUE(is_tiling(w, h, pieces, r.path)) << w << "x" << h << " " << to_string(r.winner);
+    }
+}
+
+TEST(PortfolioSolverTest, UnsolvableTest) {
+    // feasible (area, parity, coverage) but no tiling
+    auto pieces = PieceLibrary::get_piece_by_id({1, 2, 3, 6, 7});
+    for (int threads : {1, kPortfolioStrategies}) {
+        PortfolioOptions options;
+        options.threads = threads;
+        options.head_start_nodes = 1;
+        PortfolioResult r = solve_portfolio(5, 5, pieces, options);
+        EXPECT_FALSE(r.solved);
+        EXPECT_TRUE(r.path.empty());
+    }
+}
+
+TEST(PortfolioSolverTest, ThreadCapTest) {
+    PortfolioOptions options;
+    options.threads = 64;
+    options.head_start_nodes = 1;
+    auto pieces = PieceLibrary::get_piece_by_id({0, 2, 3, 4, 5, 6, 9, 10});
+    PortfolioResult r = solve_portfolio(8, 5, pieces, options);
+    EXPECT_TRUE(r.solved);
+    EXPECT_EQ(kPortfolioStrategies, r.threads);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/web/prefork.h"
+
+namespace fs = std::filesystem;
+
+// "index pid" per worker start
+static std::vector<std::pair<int, int>> read_starts(const fs::path& file) {
+    std::vector<std::pair<int, int>> out;
+    std::ifstream in(file);
+    int index, pid;
+    while (in >> index >> pid) out.emplace_back(index, pid);
+    return out;
+}
+
+TEST(PreforkTest, RestartsCrashedWorkerTest) {
+    const fs::path file = fs::temp_directory_path() / ("ut_prefork_" + std::to_string(getpid()) + ".txt");
+    fs::remove(file);
+
+    const pid_t supervisor = fork();
+    ASSERT_GE(supervisor, 0);
+    if (supervisor == 0) {
+        PreforkOptions options;
+        options.workers = 2;
+        options.stop_timeout_ms = 2000;
+        std::_Exit(run_prefork(options, [&](int index) {
+            const std::string line = std::to_string(index) + " " + std::to_string(getpid()) + "\n";
+            const int fd = open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+            (void)!write(fd, line.data(), line.size());
+            close(fd);
+            if (index == 0) std::abort();   // worker 0 crashes on every start
+            pause();
+            return 0;
+        }));
+    }
+
+    // worker 0 keeps coming back (with backoff); worker 1 stays up
+    std::vector<std::pair<int, int>> starts;
+    for (int i = 0; i < 200; ++i) {
+        starts = read_starts(file);
+        int zero = 0;
+        for (const auto& s : starts) zero += s.first == 0;
+        if (zero >= 3) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    }
+
+    int zero = 0, one = 0;
+    for (const auto& s : starts) (s.first == 0 ? zero : one) += 1;
+    EXPECT_GE(zero, 3);
+    EXPECT_EQ(one, 1);
+
+    ASSERT_EQ(kill(supervisor, SIGTERM), 0);
+    int status = 0;
+    ASSERT_EQ(waitpid(supervisor, &status, 0), supervisor);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    // every worker was stopped and reaped
+    for (const auto& s : read_starts(file)) {
+        EXPECT_NE(kill(s.second, 0), 0) << s.second;
+    }
+    fs::remove(file);
+}
+
+#endif
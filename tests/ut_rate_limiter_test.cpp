@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/web/rate_limiter.h"
+
+using namespace std::chrono_literals;
+
+TEST(RateLimiterTest, BurstThenRefillTest) {
+    RateLimitConfig config;
+    config.capacity = 100;
+    config.refill_per_second = 10;
+    RateLimiter limiter(config);
+    const auto t0 = RateLimiter::Clock::time_point{} + 1h;
+
+    EXPECT_TRUE(limiter.acquire("a", 60, t0).allowed);
+    RateDecision d = limiter.acquire("a", 60, t0);
+    EXPECT_FALSE(d.allowed);
+    EXPECT_DOUBLE_EQ(d.remaining, 40);
+    EXPECT_DOUBLE_EQ(d.retry_after, 2.0);
+    EXPECT_DOUBLE_EQ(d.reset_after, 6.0);
+
+    // another client has its own bucket
+    EXPECT_TRUE(limiter.acquire("b", 60, t0).allowed);
+
+    EXPECT_FALSE(limiter.acquire("a", 60, t0 + 1s).allowed);
+    d = limiter.acquire("a", 60, t0 + 2s);
+    EXPECT_TRUE(d.allowed);
+    EXPECT_DOUBLE_EQ(d.remaining, 0);
+
+    // refill stops at capacity; oversized requests are charged as capacity
+    EXPECT_TRUE(limiter.acquire("a", 1e9, t0 + 1000s).allowed);
+    EXPECT_FALSE(limiter.acquire("a", 1, t0 + 1000s).allowed);
+}
+
+TEST(RateLimiterTest, EvictsLeastRecentlySeenTest) {
+    RateLimitConfig config;
+    config.capacity = 10;
+    config.refill_per_second = 1;
+    config.shards = 1;
+    config.max_clients_per_shard = 4;
+    RateLimiter limiter(config);
+    const auto t0 = RateLimiter::Clock::time_point{} + 1h;
+
+    for (int i = 0; i < 4; ++i) limiter.acquire("c" + std::to_string(i), 5, t0);
+    limiter.acquire("c0", 10, t0 + 5s);    // c0 empty and seen most recently
+    EXPECT_EQ(limiter.client_count(), 4u);
+
+    limiter.acquire("new", 1, t0 + 5s);    // pushes out c1
+    EXPECT_EQ(limiter.client_count(), 4u);
+    EXPECT_FALSE(limiter.acquire("c0", 1, t0 + 5s).allowed);
+
+    // a flood of fresh ids with drained buckets never grows the shard
+    for (int i = 0; i < 1000; ++i) limiter.acquire("flood" + std::to_string(i), 10, t0 + 5s);
+    EXPECT_EQ(limiter.client_count(), 4u);
+}
+
+TEST(RateLimiterTest, ConcurrentClientsTest) {
+    RateLimitConfig config;
+    config.capacity = 1000;
+    config.refill_per_second = 1e-6;
+    RateLimiter limiter(config);
+    const auto t0 = RateLimiter::Clock::time_point{} + 1h;
+
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i) {
+                if (limiter.acquire("client" + std::to_string(i % 8), 1, t0).allowed) ++allowed;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    // 8 clients x 1000 tokens, 8000 requests: every one fits exactly
+    EXPECT_EQ(allowed.load(), 8000);
+    EXPECT_FALSE(limiter.acquire("client0", 1, t0).allowed);
+    EXPECT_EQ(limiter.client_count(), 8u);
+}
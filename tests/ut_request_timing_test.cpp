@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "../src/web/request_timing.h"
+
+TEST(RequestTimingTest, SpanClockTest) {
+    const auto wall0 = std::chrono::steady_clock::now();
+    const uint64_t t0 = SpanClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const uint64_t t1 = SpanClock::now();
+    const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall0).count();
+
+    const double ms = SpanClock::to_ms(t1 - t0);
+    EXPECT_GT(ms, 15.0);
+    EXPECT_LT(ms, wall_ms * 1.1 + 1.0);
+}
+
+TEST(RequestTimingTest, ServerTimingTest) {
+    RequestTimer timer;
+    { ScopedSpan span(&timer, "parse"); }
+    {
+        ScopedSpan span(&timer, "search");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    { ScopedSpan span(&timer, "parse"); }     // accumulates
+    { ScopedSpan span(nullptr, "ignored"); }
+
+    ASSERT_EQ(timer.span_count(), 2);
+    EXPECT_STREQ(timer.span_name(0), "parse");
+    EXPECT_STREQ(timer.span_name(1), "search");
+    EXPECT_GE(timer.span_ms(1), 1.5);
+
+    const std::string header = timer.server_timing();
+    EXPECT_EQ(header.rfind("parse;dur=", 0), 0u);
+    EXPECT_NE(header.find(", search;dur="), std::string::npos);
+    EXPECT_NE(header.find(", total;dur="), std::string::npos);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include "../src/engine/board.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/search_trace.h"
+#include "../src/engine/solver.h"
+
+TEST(SearchTraceTest, RingDropsWhenFullTest) {
+    TraceRecorder rec(4);
+    for (int i = 0; i < 6; ++i) rec.record(TraceEventKind::Place, i, 0, Cell{i, 0});
+
+    std::vector<TraceEvent> events;
+    EXPECT_EQ(4u, rec.drain(events));
+    EXPECT_EQ(2u, rec.dropped());
+    EXPECT_EQ(3, events[3].piece_id);
+
+    // space again after draining
+    rec.record(TraceEventKind::Remove, 7, 1, Cell{2, 3});
+    EXPECT_EQ(1u, rec.drain(events));
+    EXPECT_EQ((uint8_t)TraceEventKind::Remove, events.back().kind);
+    EXPECT_EQ(3, events.back().y);
+}
+
+TEST(SearchTraceTest, SamplingAndCapTest) {
+    TraceRecorder sampled(64, 3);
+    for (int i = 0; i < 9; ++i) sampled.record(TraceEventKind::Place, i, 0, Cell{0, 0});
+    EXPECT_EQ(9u, sampled.seen());
+    EXPECT_EQ(3u, sampled.kept());
+
+    TraceRecorder capped(64, 1, 5);
+    for (int i = 0; i < 9; ++i) capped.record(TraceEventKind::Place, i, 0, Cell{0, 0});
+    EXPECT_EQ(5u, capped.kept());
+    EXPECT_TRUE(capped.truncated());
+}
+
+TEST(SearchTraceTest, SolverEventsReplayToSolutionTest) {
+    auto pieces = PieceLibrary::get_piece_by_id({0, 3, 11, 10, 4});
+    Board board{5, 5};
+    Solver solver(board, pieces);
+
+    TraceRecorder rec(1u << 20);
+    solver.set_trace(&rec);
+    ASSERT_TRUE(solver.solve());
+
+    std::vector<TraceEvent> events;
+    rec.drain(events);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(0u, rec.dropped());
+    EXPECT_EQ((uint8_t)TraceEventKind::Solved, events.back().kind);
+
+    // replaying place/remove leaves exactly the final path on the board
+    std::vector<TraceEvent> stack;
+    for (const auto& ev : events) {
+        if (ev.kind == (uint8_t)TraceEventKind::Place) stack.push_back(ev);
+        if (ev.kind == (uint8_t)TraceEventKind::Remove) {
+            ASSERT_FALSE(stack.empty());
+            EXPECT_EQ(stack.back().piece_id, ev.piece_id);
+            stack.pop_back();
+        }
+    }
+    const auto& path = solver.get_placements_path();
+    ASSERT_EQ(path.size(), stack.size());
+    for (size_t i = 0; i < path.size(); ++i) {
+        EXPECT_EQ(path[i].get_piece_id(), stack[i].piece_id);
+        EXPECT_EQ(path[i].get_variant_index(), stack[i].variant_index);
+        EXPECT_EQ(path[i].get_offset().x, stack[i].x);
+        EXPECT_EQ(path[i].get_offset().y, stack[i].y);
+    }
+}
+
+TEST(SearchTraceTest, SampledEventsStillReplayTest) {
+    auto pieces = PieceLibrary::get_piece_by_id({0, 3, 11, 10, 4});
+    Board board{5, 5};
+    Solver solver(board, pieces);
+
+    TraceRecorder rec(1u << 20, 3);
+    solver.set_trace(&rec);
+    ASSERT_TRUE(solver.solve());
+
+    std::vector<TraceEvent> events;
+    rec.drain(events);
+    EXPECT_LT(rec.kept(), rec.seen());
+
+    // every kept Remove undoes the last kept Place; what stays is part of the path
+    std::vector<TraceEvent> stack;
+    for (const auto& ev : events) {
+        if (ev.kind == (uint8_t)TraceEventKind::Place) stack.push_back(ev);
+        if (ev.kind == (uint8_t)TraceEventKind::Remove) {
+            ASSERT_FALSE(stack.empty());
+            EXPECT_EQ(stack.back().piece_id, ev.piece_id);
+            EXPECT_EQ(stack.back().x, ev.x);
+            EXPECT_EQ(stack.back().y, ev.y);
+            stack.pop_back();
+        }
+    }
+    const auto& path = solver.get_placements_path();
+    for (const auto& ev : stack) {
+        EXPECT_TRUE(std::any_of(path.begin(), path.end(), [&](const Placement& p) {
+            return p.get_piece_id() == ev.piece_id && p.get_offset().x == ev.x && p.get_offset().y == ev.y;
+        }));
+    }
+}
+
+TEST(SearchTraceTest, FileRoundTripTest) {
+    std::vector<TraceEvent> events = {
+        {1, 4, 2, 0, 1, 2},
+        {2, 4, 2, 0, 1, 2},
+        {3, 0, 0, 0, 0, 0},
+    };
+    const std::string path = ::testing::TempDir() + "trace_roundtrip.pztr";
+    write_trace_file(path, 6, 5, events);
+
+    int w = 0, h = 0;
+    auto back = read_trace_file(path, w, h);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(6, w);
+    EXPECT_EQ(5, h);
+    ASSERT_EQ(3u, back.size());
+    EXPECT_EQ(2, back[1].variant_index);
+    EXPECT_EQ(3, back[2].kind);
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../src/engine/board.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solution_count.h"
+#include "../src/engine/solver.h"
+
+TEST(SolutionCountTest, FrontierForNarrowBoardsTest) {
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1});
+    Board board(5, 4);
+    Solver solver(board, pieces);
+    const uint64_t expected = solver.count_solutions();
+    ASSERT_GT(expected, 1u);
+
+    SolutionCount c = count_level_solutions(5, 4, pieces);
+    EXPECT_EQ(std::string(c.engine), "frontier");
+    EXPECT_EQ(c.count, expected);
+    EXPECT_TRUE(c.complete);
+
+    // the DP counts them all whatever the limit
+    c = count_level_solutions(5, 4, pieces, 1);
+    EXPECT_EQ(c.count, expected);
+    EXPECT_TRUE(c.complete);
+}
+
+TEST(SolutionCountTest, SearchForWideBoardsTest) {
+    // short side 8: past the frontier DP, and 80 cells: past the bitmask tables
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(std::vector<int>(16, 3));
+    SolutionCount c = count_level_solutions(10, 8, pieces, 3);
+    EXPECT_EQ(std::string(c.engine), "generic");
+    EXPECT_EQ(c.count, 3u);
+    EXPECT_FALSE(c.complete);
+}
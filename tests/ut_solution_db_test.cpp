@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solver.h"
+#include "../src/engine/board.h"
+#include "../src/web/hint_service.h"
+#include "../src/web/solution_db.h"
+
+namespace fs = std::filesystem;
+
+static uint64_t mask_of(const PlacementTable& table, const Placement& p) {
+    const auto& kinds = table.get_inventory().get_kinds();
+    for (const auto& tp : table.get_placements()) {
+        if (kinds[tp.kind_index].piece->get_id() == p.get_piece_id() &&
+            tp.variant_index == p.get_variant_index() && tp.offset == p.get_offset()) {
+            return tp.mask;
+        }
+    }
+    return 0;
+}
+
+class SolutionDbTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        file = fs::temp_directory_path() / "ut_solution_db.soldb";
+        std::vector<solutiondb::SourceLevel> levels;
+        levels.push_back(solutiondb::enumerate_level(7, 5, PieceLibrary::get_piece_by_id({8, 0, 1, 3, 11, 4, 9})));
+        levels.push_back(solutiondb::enumerate_level(5, 5, PieceLibrary::get_piece_by_id({0, 3, 11, 10, 4})));
+        levels.push_back(solutiondb::enumerate_level(5, 5, PieceLibrary::get_piece_by_id({4, 3, 11, 10, 0})));
+        solutiondb::write_db(file.string(), levels);
+        db = SolutionDb::open(file.string());
+    }
+
+    void TearDown() override { fs::remove(file); }
+
+    fs::path file;
+    std::unique_ptr<SolutionDb> db;
+};
+
+TEST_F(SolutionDbTest, StoresEverySolutionTest) {
+    EXPECT_EQ(2u, db->level_count());   // the reordered 5x5 level is the same instance
+
+    const auto* lv = db->find_level(7, 5, {9, 4, 11, 3, 1, 0, 8});
+    ASSERT_NE(nullptr, lv);
+    EXPECT_TRUE(lv->flags & solutiondb::kLevelComplete);
+
+    auto pieces = PieceLibrary::get_piece_by_id(db->piece_ids(*lv));
+    Board board{7, 5};
+    Solver solver(board, pieces);
+    EXPECT_EQ(solver.count_solutions(), lv->solution_count);
+
+    // the first record is the solver's first solution, and records are sorted
+    ASSERT_TRUE(solver.solve());
+    PlacementTable table(7, 5, pieces);
+    const auto first = db->decode(*lv, table, 0);
+    ASSERT_EQ(solver.get_placements_path().size(), first.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(solver.get_placements_path()[i].get_piece_id(), first[i].get_piece_id());
+    }
+    for (uint64_t i = 1; i < lv->solution_count; ++i) {
+        auto a = db->solution(*lv, i - 1), b = db->solution(*lv, i);
+        EXPECT_TRUE(std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+    }
+
+    EXPECT_EQ(nullptr, db->find_level(5, 7, {9, 4, 11, 3, 1, 0, 8}));
+}
+
+TEST_F(SolutionDbTest, PrefixRangeTest) {
+    const auto* lv = db->find_level(7, 5, {8, 0, 1, 3, 11, 4, 9});
+    ASSERT_NE(nullptr, lv);
+
+    auto all = db->prefix_range(*lv, {});
+    EXPECT_EQ(0u, all.first);
+    EXPECT_EQ(lv->solution_count, all.second);
+
+    auto s = db->solution(*lv, lv->solution_count / 2);
+    std::vector<uint8_t> prefix(s.begin(), s.begin() + 2);
+    auto [lo, hi] = db->prefix_range(*lv, prefix);
+    ASSERT_LT(lo, hi);
+    for (uint64_t i = 0; i < lv->solution_count; ++i) {
+        auto r = db->solution(*lv, i);
+        const bool match = r[0] == prefix[0] && r[1] == prefix[1];
+        EXPECT_EQ(match, i >= lo && i < hi);
+    }
+}
+
+TEST_F(SolutionDbTest, ConsistentMatchesBruteForceTest) {
+    const auto* lv = db->find_level(7, 5, {8, 0, 1, 3, 11, 4, 9});
+    ASSERT_NE(nullptr, lv);
+    auto pieces = PieceLibrary::get_piece_by_id(db->piece_ids(*lv));
+    PlacementTable table(7, 5, pieces);
+
+    // fix two pieces of some solution, not taken in search order
+    const auto path = db->decode(*lv, table, lv->solution_count - 1);
+    std::vector<PlacedPiece> placed{
+        {path.back().get_piece_id(), mask_of(table, path.back())},
+        {path[2].get_piece_id(), mask_of(table, path[2])},
+    };
+
+    std::vector<uint64_t> expected;
+    for (uint64_t i = 0; i < lv->solution_count; ++i) {
+        const auto sol = db->decode(*lv, table, i);
+        bool all = true;
+        for (const auto& p : placed) {
+            bool found = false;
+            for (const auto& q : sol) found |= q.get_piece_id() == p.piece_id && mask_of(table, q) == p.mask;
+            all &= found;
+        }
+        if (all) expected.push_back(i);
+    }
+
+    EXPECT_EQ(expected, db->consistent(*lv, table, placed));
+    EXPECT_EQ(std::vector<uint64_t>{expected.front()}, db->consistent(*lv, table, placed, 1));
+    EXPECT_EQ(lv->solution_count, db->consistent(*lv, table, {}).size());
+}
+
+TEST_F(SolutionDbTest, HintFromDatabaseTest) {
+    HintService hints;
+    hints.set_solution_db(db.get());
+
+    HintRequest req;
+    req.width = 7;
+    req.height = 5;
+    req.piece_ids = {8, 0, 1, 3, 11, 4, 9};
+
+    HintResult r = hints.hint(req);
+    ASSERT_EQ(HintStatus::Next, r.status);
+    EXPECT_EQ(HintSource::Database, r.source);
+    EXPECT_EQ(0u, hints.cached_levels());
+
+    // upright I in column 1: dead end, proven by the complete level
+    HintPiece i_piece;
+    i_piece.pieceId = 8;
+    for (int y = 0; y < 5; ++y) i_piece.cells.push_back(CellDTO{1, y});
+    req.placed.push_back(i_piece);
+    r = hints.hint(req);
+    EXPECT_EQ(HintStatus::DeadEnd, r.status);
+    EXPECT_EQ(HintSource::Database, r.source);
+}
+
+static std::vector<char> read_bytes(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+static void write_bytes(const fs::path& file, const std::vector<char>& bytes) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), (std::streamsize)bytes.size());
+}
+
+TEST_F(SolutionDbTest, RejectsWrappingCountsTest) {
+    std::vector<char> bytes = read_bytes(file);
+    solutiondb::DbHeader h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    solutiondb::DbLevel lv;
+    std::memcpy(&lv, bytes.data() + h.levels_offset, sizeof(lv));
+
+    // solution_count * piece_count wraps around to a small number
+    lv.solution_count = UINT64_MAX / lv.piece_count + 1;
+    std::memcpy(bytes.data() + h.levels_offset, &lv, sizeof(lv));
+    write_bytes(file, bytes);
+    EXPECT_THROW(SolutionDb::open(file.string()), std::runtime_error);
+}
+
+TEST_F(SolutionDbTest, CorruptRecordsFailQueriesTest) {
+    std::vector<char> bytes = read_bytes(file);
+    solutiondb::DbHeader h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    std::fill(bytes.begin() + (long)h.decisions_offset, bytes.end(), (char)0xff);
+    write_bytes(file, bytes);
+    auto corrupt = SolutionDb::open(file.string());
+
+    const std::vector<int> ids = {8, 0, 1, 3, 11, 4, 9};
+    const auto* lv = corrupt->find_level(7, 5, ids);
+    ASSERT_NE(nullptr, lv);
+    const auto pieces = PieceLibrary::get_piece_by_id(corrupt->piece_ids(*lv));
+    const PlacementTable table(7, 5, pieces);
+    EXPECT_THROW(corrupt->decode(*lv, table, 0), std::runtime_error);
+    EXPECT_THROW(corrupt->consistent(*lv, table, {}), std::runtime_error);
+
+    // /hint falls back to solving
+    HintService hints;
+    hints.set_solution_db(corrupt.get());
+    HintRequest req;
+    req.width = 7;
+    req.height = 5;
+    req.piece_ids = ids;
+    HintResult r = hints.hint(req);
+    ASSERT_EQ(HintStatus::Next, r.status);
+    EXPECT_EQ(HintSource::Cache, r.source);
+}
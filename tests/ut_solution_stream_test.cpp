@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "../src/engine/iterative_solver.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solution_stream.h"
+#include "../src/web/solve_api.h"
+
+namespace fs = std::filesystem;
+
+struct CollectDecisions : SolutionSink {
+    std::vector<std::vector<uint16_t>> all;
+    void on_solution(const uint16_t* decisions, size_t count) override {
+        all.emplace_back(decisions, decisions + count);
+    }
+};
+
+TEST(SolutionStreamTest, RoundTripTest) {
+    const std::vector<int> ids(12, 3);     // 808 tilings of 10x6
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id(ids);
+    IterativeSolver solver(10, 6, pieces);
+
+    CollectDecisions expected;
+    const uint64_t n = solver.enumerate(expected);
+    ASSERT_EQ(n, 808u);
+    EXPECT_EQ(n, solver.count_solutions());
+
+    const fs::path file = fs::temp_directory_path() / "ut_solution_stream.bin";
+    {
+        // tiny buffers: many hand-offs to the writer thread
+        SolutionFileWriter writer(file.string(), solver.get_table(), ids, 100);
+        EXPECT_EQ(solver.enumerate(writer), n);
+        writer.close();
+        EXPECT_EQ(writer.solution_count(), n);
+    }
+    EXPECT_EQ(fs::file_size(file), sizeof(solutionstream::StreamHeader) + ids.size() * 2 + n * ids.size());
+
+    SolutionFileReader reader(file.string());
+    EXPECT_EQ(reader.get_width(), 10);
+    EXPECT_EQ(reader.get_height(), 6);
+    EXPECT_EQ(reader.get_piece_ids(), ids);
+    ASSERT_EQ(reader.size(), n);
+
+    for (uint64_t i = 0; i < n; ++i) {
+        ASSERT_EQ(reader.decisions(i), expected.all[i]) << i;
+    }
+
+    // the last record read back as a covering of the board
+    std::vector<PlacementDTO> dtos = read_stream_solution(reader, n - 1);
+    ASSERT_EQ(dtos.size(), ids.size());
+    std::set<std::pair<int, int>> cells;
+    for (const auto& p : dtos) {
+        for (const auto& c : p.cells) cells.insert({c.x, c.y});
+    }
+    EXPECT_EQ(cells.size(), 60u);
+
+    EXPECT_THROW(reader.placements(n), std::out_of_range);
+    fs::remove(file);
+}
+
+TEST(SolutionStreamTest, LimitAndBadFileTest) {
+    const std::vector<int> ids = {0, 1, 2};
+    IterativeSolver solver(3, 5, PieceLibrary::get_piece_by_id(ids));
+    CollectDecisions sink;
+    EXPECT_EQ(solver.enumerate(sink, 1), 1u);
+    EXPECT_EQ(sink.all.size(), 1u);
+
+    EXPECT_THROW(SolutionFileReader("/nonexistent/solutions.bin"), std::runtime_error);
+    const fs::path file = fs::temp_directory_path() / "ut_solution_stream_bad.bin";
+    { std::ofstream(file) << "not a stream"; }
+    EXPECT_THROW(SolutionFileReader(file.string()), std::runtime_error);
+    fs::remove(file);
+}
+
+TEST(SolutionStreamTest, CorruptRecordTest) {
+    const std::vector<int> ids = {0, 1, 2};
+    IterativeSolver solver(3, 5, PieceLibrary::get_piece_by_id(ids));
+    const fs::path file = fs::temp_directory_path() / "ut_solution_stream_corrupt.bin";
+    {
+        SolutionFileWriter writer(file.string(), solver.get_table(), ids);
+        EXPECT_EQ(solver.enumerate(writer, 1), 1u);
+        writer.close();
+    }
+    EXPECT_EQ(SolutionFileReader(file.string()).placements(0).size(), ids.size());
+
+    // one byte per decision; the first one points past its cell's candidates
+    {
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-(std::streamoff)ids.size(), std::ios::end);
+        f.put((char)0xff);
+    }
+    SolutionFileReader reader(file.string());
+    EXPECT_THROW(reader.placements(0), std::runtime_error);
+    fs::remove(file);
+}
+
+TEST(SolutionStreamTest, CorruptHeaderTest) {
+    const std::vector<int> ids = {0, 1, 2};
+    IterativeSolver solver(3, 5, PieceLibrary::get_piece_by_id(ids));
+    const fs::path file = fs::temp_directory_path() / "ut_solution_stream_header.bin";
+    {
+        SolutionFileWriter writer(file.string(), solver.get_table(), ids);
+        EXPECT_EQ(solver.enumerate(writer, 1), 1u);
+        writer.close();
+    }
+    auto patch = [&](size_t offset, const void* value, size_t size) {
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp((std::streamoff)offset);
+        f.write(static_cast<const char*>(value), (std::streamsize)size);
+    };
+
+    // count * 3-byte records wraps to 2 bytes, which the file holds
+    const uint64_t wrapping = UINT64_MAX / 3 + 1;
+    patch(offsetof(solutionstream::StreamHeader, solution_count), &wrapping, sizeof(wrapping));
+    EXPECT_THROW(SolutionFileReader(file.string()), std::runtime_error);
+
+    // no pieces: zero-byte records
+    const uint64_t one = 1;
+    const uint16_t none = 0;
+    patch(offsetof(solutionstream::StreamHeader, solution_count), &one, sizeof(one));
+    patch(offsetof(solutionstream::StreamHeader, piece_count), &none, sizeof(none));
+    EXPECT_THROW(SolutionFileReader(file.string()), std::runtime_error);
+    fs::remove(file);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../src/web/solve_coalescer.h"
+
+static SolveRequest make_request(std::vector<int> ids) {
+    SolveRequest sr;
+    sr.width = 5;
+    sr.height = 3;
+    sr.piece_ids = std::move(ids);
+    return sr;
+}
+
+static void wait_for_waiters(const SolveCoalescer& c, uint64_t n) {
+    while (c.get_stats().waiting < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+TEST(SolveCoalescerTest, InstanceKeyTest) {
+    EXPECT_EQ(SolveCoalescer::instance_key(make_request({3, 1, 2})),
+              SolveCoalescer::instance_key(make_request({1, 2, 3})));
+    EXPECT_NE(SolveCoalescer::instance_key(make_request({1, 2, 3})),
+              SolveCoalescer::instance_key(make_request({1, 2, 4})));
+
+    SolveRequest turned = make_request({1, 2, 3});
+    std::swap(turned.width, turned.height);
+    EXPECT_NE(SolveCoalescer::instance_key(turned), SolveCoalescer::instance_key(make_request({1, 2, 3})));
+
+    // a portfolio race answers differently from a single engine
+    SolveRequest raced = make_request({1, 2, 3});
+    raced.portfolio_threads = 4;
+    EXPECT_NE(SolveCoalescer::instance_key(raced), SolveCoalescer::instance_key(make_request({1, 2, 3})));
+}
+
+TEST(SolveCoalescerTest, DuplicatesShareOneRunTest) {
+    SolveCoalescer coalescer;
+    std::atomic<int> runs{0};
+    std::atomic<bool> release{false};
+
+    auto slow = [&](const SolveRequest&) {
+        ++runs;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        SolveResult r;
+        r.solved = true;
+        r.strategy = "leader";
+        return r;
+    };
+
+    const int n = 6;
+    std::vector<std::thread> threads;
+    std::atomic<int> shared{0};
+    for (int i = 0; i < n; ++i) {
+        threads.emplace_back([&, i] {
+            bool coalesced = false;
+            SolveResult r = coalescer.solve(make_request(i % 2 ? std::vector<int>{2, 1, 3} : std::vector<int>{1, 2, 3}),
+                                            slow, &coalesced);
+            EXPECT_TRUE(r.solved);
+            EXPECT_EQ(r.strategy, "leader");
+            shared += coalesced;
+        });
+    }
+    wait_for_waiters(coalescer, n - 1);
+    release = true;
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(runs.load(), 1);
+    EXPECT_EQ(shared.load(), n - 1);
+    CoalescerStats st = coalescer.get_stats();
+    EXPECT_EQ(st.leaders, 1u);
+    EXPECT_EQ(st.coalesced, (uint64_t)n - 1);
+    EXPECT_EQ(st.in_flight, 0u);
+    EXPECT_EQ(st.waiting, 0u);
+
+    // nothing is cached once the flight has landed
+    coalescer.solve(make_request({1, 2, 3}), slow);
+    EXPECT_EQ(runs.load(), 2);
+}
+
+TEST(SolveCoalescerTest, WaiterTakesOverTest) {
+    SolveCoalescer coalescer;
+    std::atomic<bool> release{false};
+    std::atomic<int> runs{0};
+
+    std::thread leader([&] {
+        auto cancelled = [&](const SolveRequest&) -> SolveResult {
+            ++runs;
+            while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            throw SolveCancelled();
+        };
+        EXPECT_THROW(coalescer.solve(make_request({1, 2, 3}), cancelled), SolveCancelled);
+    });
+    while (coalescer.get_stats().in_flight == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<std::thread> waiters;
+    std::atomic<int> shared{0};
+    for (int i = 0; i < 3; ++i) {
+        waiters.emplace_back([&] {
+            auto ok = [&](const SolveRequest&) {
+                ++runs;
+                SolveResult r;
+                r.solved = true;
+                return r;
+            };
+            bool coalesced = false;
+            EXPECT_TRUE(coalescer.solve(make_request({3, 2, 1}), ok, &coalesced).solved);
+            shared += coalesced;
+        });
+    }
+    wait_for_waiters(coalescer, 3);
+    release = true;
+    leader.join();
+    for (auto& t : waiters) t.join();
+
+    CoalescerStats st = coalescer.get_stats();
+    // a waiter that wakes after the new leader finished starts another run
+    EXPECT_GE(st.takeovers, 1u);
+    EXPECT_EQ(st.leaders + st.coalesced, 4u);
+    EXPECT_EQ(runs.load(), (int)st.leaders);
+    EXPECT_EQ(shared.load(), (int)st.coalesced);
+    EXPECT_EQ(st.in_flight, 0u);
+}
+
+TEST(SolveCoalescerTest, FailureReachesWaitersTest) {
+    SolveCoalescer coalescer;
+    std::atomic<bool> release{false};
+    std::atomic<int> runs{0};
+
+    auto failing = [&](const SolveRequest&) -> SolveResult {
+        ++runs;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        throw std::runtime_error("out of memory");
+    };
+    std::thread leader([&] { EXPECT_THROW(coalescer.solve(make_request({1, 2, 3}), failing), std::runtime_error); });
+    while (coalescer.get_stats().in_flight == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 3; ++i) {
+        waiters.emplace_back([&] { EXPECT_THROW(coalescer.solve(make_request({3, 2, 1}), failing), std::runtime_error); });
+    }
+    wait_for_waiters(coalescer, 3);
+    release = true;
+    leader.join();
+    for (auto& t : waiters) t.join();
+
+    // not a cancellation: nobody retries
+    EXPECT_EQ(runs.load(), 1);
+    CoalescerStats st = coalescer.get_stats();
+    EXPECT_EQ(st.leaders, 1u);
+    EXPECT_EQ(st.takeovers, 0u);
+    EXPECT_EQ(st.in_flight, 0u);
+    EXPECT_EQ(st.waiting, 0u);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+#include "../src/web/solve_api.h"
+
+// Solution as the sorted list of its pieces' cells, to compare pages.
+static std::vector<std::vector<int>> canonical(const std::vector<PlacementDTO>& placements) {
+    std::vector<std::vector<int>> out;
+    for (const auto& p : placements) {
+        std::vector<int> cells;
+        for (const auto& c : p.cells) cells.push_back(p.pieceId * 10000 + c.y * 100 + c.x);
+        std::sort(cells.begin(), cells.end());
+        out.push_back(std::move(cells));
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+TEST(SolvePageTest, PagesCoverEverySolutionOnceTest) {
+    SolveRequest req;
+    req.width = 10;
+    req.height = 6;
+    req.piece_ids.assign(12, 3);    // 808 tilings
+    req.limit = 100;
+
+    std::set<std::vector<std::vector<int>>> seen;
+    uint64_t expected_index = 0;
+    int pages = 0;
+    for (;;) {
+        SolvePage page = solve_page(req);
+        ASSERT_TRUE(page.error_message.empty()) << page.error_message;
+        EXPECT_EQ(page.first_index, expected_index);
+        EXPECT_LE(page.solutions.size(), 100u);
+        for (const auto& s : page.solutions) EXPECT_TRUE(seen.insert(canonical(s)).second);
+        expected_index += page.solutions.size();
+        ++pages;
+        if (page.next_cursor.empty()) break;
+        req.cursor = page.next_cursor;
+        ASSERT_LT(pages, 20);
+    }
+    EXPECT_EQ(seen.size(), 808u);
+    EXPECT_EQ(pages, 9);
+}
+
+TEST(SolvePageTest, BudgetAndBadCursorTest) {
+    SolveRequest req;
+    req.width = 10;
+    req.height = 6;
+    req.piece_ids.assign(12, 3);
+    req.limit = 5;
+
+    // a tiny budget ends pages early, but the cursor still makes progress
+    uint64_t found = 0;
+    int pages = 0;
+    do {
+        SolvePage page = solve_page(req, 50);
+        ASSERT_TRUE(page.error_message.empty()) << page.error_message;
+        EXPECT_EQ(page.first_index, found);
+        found += page.solutions.size();
+        req.cursor = page.next_cursor;
+        ++pages;
+    } while (!req.cursor.empty() && found < 20);
+    EXPECT_GE(found, 20u);
+    EXPECT_GT(pages, 4);
+
+    req.cursor = "not a cursor!";
+    EXPECT_FALSE(solve_page(req).error_message.empty());
+
+    // a cursor only resumes the instance it came from
+    req.cursor.clear();
+    const std::string cursor = solve_page(req).next_cursor;
+    ASSERT_FALSE(cursor.empty());
+    req.width = 6;
+    req.height = 10;
+    req.cursor = cursor;
+    SolvePage other = solve_page(req);
+    EXPECT_NE(other.error_message.find("Invalid cursor"), std::string::npos);
+    EXPECT_TRUE(other.solutions.empty());
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "../src/engine/board.h"
+#include "../src/engine/piece_library.h"
+#include "../src/engine/solver_strategy.h"
+
+static bool covers_board(int w, int h, const std::vector<Piece>& pieces, const std::vector<Placement>& path) {
+    Board board(w, h);
+    for (const auto& p : path) {
+        const Piece* piece = nullptr;
+        for (const auto& x : pieces) if (x.get_id() == p.get_piece_id()) piece = &x;
+        const auto& variant = piece->get_variants()[p.get_variant_index()];
+        if (!board.can_place(variant, p.get_offset())) return false;
+        board.place(p.get_piece_id(), variant, p.get_offset());
+    }
+    for (int v : board.get_grid()) if (v < 0) return false;
+    return true;
+}
+
+TEST(SolverStrategyTest, EveryEngineSolvesTest) {
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1});
+    const SolverRegistry& registry = SolverRegistry::instance();
+
+    std::set<std::string> names;
+    for (const auto& name : registry.names()) names.insert(name);
+    for (const char* name : {"kernel", "filter", "iterative", "generic"}) {
+        ASSERT_TRUE(names.count(name)) << name;
+        const SolverStrategy* engine = registry.select(name, 4, 5, pieces);
+        ASSERT_NE(engine, nullptr) << name;
+        std::vector<Placement> path;
+        ASSERT_TRUE(engine->solve(4, 5, pieces, path)) << name;
+        EXPECT_TRUE(covers_board(4, 5, pieces, path)) << name;
+    }
+
+    const SolverStrategy* chosen = registry.select("auto", 4, 5, pieces);
+    ASSERT_NE(chosen, nullptr);
+    EXPECT_TRUE(chosen->supports(4, 5));
+
+    EXPECT_EQ(registry.select("no-such-engine", 4, 5, pieces), nullptr);
+}
+
+TEST(SolverStrategyTest, SupportAndCostTest) {
+    const SolverRegistry& registry = SolverRegistry::instance();
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1});
+
+    // no FixedSolver kernel for 2x10, and 13x5 is past the 64-cell tables
+    EXPECT_EQ(registry.select("kernel", 2, 10, pieces), nullptr);
+    EXPECT_EQ(registry.select("iterative", 13, 5, pieces), nullptr);
+    EXPECT_STREQ(registry.choose(13, 5, PieceLibrary::make_all_pieces())->name(), "generic");
+
+    const InstanceFeatures small = describe_instance(4, 5, pieces);
+    const InstanceFeatures large = describe_instance(10, 6, PieceLibrary::make_all_pieces());
+    EXPECT_GT(small.placements, 0);
+    EXPECT_GT(large.placements, small.placements);
+    EXPECT_GT(CostModel::expected_nodes(large), CostModel::expected_nodes(small));
+
+    // the generic Solver has no setup, the bitmask engines win on long searches
+    EXPECT_STRNE(registry.choose(10, 6, PieceLibrary::make_all_pieces())->name(), "generic");
+}
+
+TEST(SolverStrategyTest, RegisterTest) {
+    class Never : public SolverStrategy {
+    public:
+        const char* name() const override { return "test-never"; }
+        bool supports(int, int) const override { return true; }
+        double estimate_us(const InstanceFeatures&) const override { return 1e18; }
+        bool solve(int, int, const std::vector<Piece>&, std::vector<Placement>&) const override { return false; }
+    };
+    SolverRegistry& registry = SolverRegistry::instance();
+    registry.add(std::make_unique<Never>());
+    registry.add(std::make_unique<Never>());    // replaces, not duplicates
+
+    size_t n = 0;
+    for (const auto& name : registry.names()) n += name == "test-never";
+    EXPECT_EQ(n, 1u);
+    EXPECT_NE(registry.find("test-never"), nullptr);
+
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 1, 2});
+    EXPECT_STRNE(registry.choose(3, 5, pieces)->name(), "test-never");
+}
+
+TEST(SolverStrategyTest, SolveWithStatsTest) {
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1});
+    const SolverRegistry& registry = SolverRegistry::instance();
+
+    for (const char* name : {"filter", "iterative"}) {
+        SearchStats stats;
+        std::vector<Placement> path;
+        ASSERT_TRUE(registry.find(name)->solve_with_stats(4, 5, pieces, path, stats)) << name;
+        EXPECT_EQ(path.size(), pieces.size()) << name;
+        EXPECT_GE(stats.nodes, pieces.size()) << name;
+        EXPECT_GE(stats.placement_tests, stats.nodes) << name;
+        EXPECT_EQ(stats.solutions, 1u) << name;
+    }
+
+    // engines without counters still solve and leave the stats alone
+    SearchStats stats;
+    std::vector<Placement> path;
+    ASSERT_TRUE(registry.find("generic")->solve_with_stats(4, 5, pieces, path, stats));
+    EXPECT_TRUE(covers_board(4, 5, pieces, path));
+    EXPECT_EQ(stats.nodes, 0u);
+}
+
+TEST(SolverStrategyTest, SolveUntilTest) {
+    const std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 6, 3, 1});
+    const SolverRegistry& registry = SolverRegistry::instance();
+
+    std::vector<Placement> path;
+    ASSERT_TRUE(registry.find("iterative")->solve_until(4, 5, pieces, path, [] { return false; }));
+    EXPECT_TRUE(covers_board(4, 5, pieces, path));
+
+    // the iterative engine gives up; an engine that cannot pause still answers
+    path.clear();
+    EXPECT_FALSE(registry.find("iterative")->solve_until(4, 5, pieces, path, [] { return true; }));
+    EXPECT_TRUE(path.empty());
+    ASSERT_TRUE(registry.find("generic")->solve_until(4, 5, pieces, path, [] { return true; }));
+    EXPECT_TRUE(covers_board(4, 5, pieces, path));
+}
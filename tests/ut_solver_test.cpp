@@ -3,6 +3,9 @@
 #include "../src/engine/board.h"
 #include "../src/engine/placement.h"
 #include "../src/engine/solver.h"
+#include "../src/engine/fixed_solver.h"
+#include "../src/engine/kernel_dispatch.h"
+#include "../src/engine/piece_library.h"
 
 TEST(PlacementTest, MakePlacementTest) {
     Cell offset{2, 3};
@@ -96,3 +99,86 @@ TEST(SolverTest, MultiplePiecesTest) {
     EXPECT_EQ(std::vector<int>({0, 1, 2}), used_piece_ids);
 
 }
+
+TEST(SolverTest, CountSolutionsTest) {
+    Board board{3, 2};
+    std::vector<Piece> pieces;
+
+    std::vector<Cell> line_shape{
+        Cell{0, 0},
+        Cell{1, 0},
+        Cell{2, 0}
+    };
+    pieces.emplace_back(Piece{0, line_shape});
+    pieces.emplace_back(Piece{1, line_shape});
+
+    // two horizontal bars, in either order
+    Solver solver(board, pieces);
+    EXPECT_EQ(2u, solver.count_solutions());
+    EXPECT_EQ(1u, solver.count_solutions(1));
+}
+
+TEST(SolverTest, FixedSolverMatchesSolverTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({0, 3, 11, 10, 4});
+
+    Board board{5, 5};
+    Solver solver(board, pieces);
+    ASSERT_TRUE(solver.solve());
+
+    FixedSolver<5, 5> fixed(pieces);
+    ASSERT_TRUE(fixed.solve());
+
+    // same search order -> same first solution
+    const auto& expected = solver.get_placements_path();
+    const auto actual = fixed.get_placements_path();
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].get_piece_id(), actual[i].get_piece_id());
+        EXPECT_EQ(expected[i].get_variant_index(), actual[i].get_variant_index());
+        EXPECT_EQ(expected[i].get_offset(), actual[i].get_offset());
+    }
+
+    board.clear();
+    EXPECT_EQ(solver.count_solutions(), fixed.count_solutions());
+}
+
+TEST(SolverTest, KernelDispatchTest) {
+    EXPECT_NE(nullptr, find_kernel(3, 5));
+    EXPECT_NE(nullptr, find_kernel(5, 8));
+    EXPECT_EQ(nullptr, find_kernel(9, 9));    // falls back to Solver
+
+    const SolverKernel* kernel = find_kernel(3, 5);
+    std::vector<Placement> path;
+    EXPECT_TRUE(kernel->solve(PieceLibrary::get_piece_by_id({0, 1, 2}), path));
+    EXPECT_EQ(3, path.size());
+}
+
+TEST(SolverTest, DuplicatePiecesCountedOnceTest) {
+    // two copies of the I piece on a 5x2 board: one tiling, not 2!
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({8, 8});
+
+    Board board{5, 2};
+    Solver solver(board, pieces);
+    ASSERT_TRUE(solver.solve());
+    ASSERT_EQ(2, solver.get_placements_path().size());
+    EXPECT_EQ(8, solver.get_placements_path()[0].get_piece_id());
+    EXPECT_EQ(8, solver.get_placements_path()[1].get_piece_id());
+
+    board.clear();
+    EXPECT_EQ(1u, solver.count_solutions());
+
+    FixedSolver<5, 2> fixed(pieces);
+    EXPECT_EQ(1u, fixed.count_solutions());
+}
+
+TEST(PieceInventoryTest, GroupByIdTest) {
+    std::vector<Piece> pieces = PieceLibrary::get_piece_by_id({3, 1, 3, 3});
+    PieceInventory inventory(pieces);
+
+    ASSERT_EQ(2, inventory.kind_count());
+    EXPECT_EQ(4, inventory.piece_count());
+    EXPECT_EQ(3, inventory.get_kinds()[0].piece->get_id());
+    EXPECT_EQ(3, inventory.get_kinds()[0].count);
+    EXPECT_EQ(1, inventory.get_kinds()[1].piece->get_id());
+    EXPECT_EQ(std::vector<int>({3, 1}), inventory.initial_counts());
+}